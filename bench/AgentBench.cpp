@@ -0,0 +1,60 @@
+// Benchmark de simulación multi-agente (AgentSystem)
+// Uso: agent_bench [ancho] [alto] [agentes] [ticks] [hilos]
+#include "Grid.h"
+#include "AgentSystem.h"
+#include "ExplorationHeatmap.h"
+#include "FlowField.h"
+
+#include "DFSAlgorithm.cpp"
+
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 128;
+    int height = argc > 2 ? std::atoi(argv[2]) : 128;
+    int agentCount = argc > 3 ? std::atoi(argv[3]) : 6000;
+    int ticks = argc > 4 ? std::atoi(argv[4]) : 2000;
+    int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+
+    if (width <= 0 || height <= 0 || agentCount <= 0 || ticks <= 0) {
+        std::cerr << "Uso: agent_bench [ancho] [alto] [agentes] [ticks] [hilos]\n";
+        return 1;
+    }
+
+    Grid grid(width, height);
+    DFSAlgorithm generator(grid);
+    generator.runToEnd();
+
+    Coord goal(width - 1, height - 1);
+    FlowField flow(grid, goal);
+
+    std::cout << "=== Agent Benchmark ===\n";
+    std::cout << "Laberinto: " << width << "x" << height
+              << " | Agentes: " << agentCount << " | Ticks: " << ticks << "\n";
+
+    auto runWith = [&](int threadCount) {
+        AgentSystem agents(grid, goal, threadCount);
+        agents.setFlowField(&flow);
+        // Un tercio de cada tipo, mismas posiciones de partida en cada corrida
+        agents.spawnRandom(agentCount / 3, AgentKind::WANDERER, 1);
+        agents.spawnRandom(agentCount / 3, AgentKind::SEEKER, 2);
+        agents.spawnRandom(agentCount - 2 * (agentCount / 3), AgentKind::FLOW, 3);
+
+        ExplorationHeatmap heatmap(width, height);
+        agents.run(ticks, &heatmap);
+
+        ExplorationHeatmap::HeatmapStats stats = heatmap.getStats();
+        std::cout << agents.getThreadCount() << " hilos: "
+                  << static_cast<long long>(agents.getLastAgentTicksPerSecond()) << " agente-ticks/s"
+                  << " | terminados " << agents.getDoneCount() << "/" << agents.getAgentCount()
+                  << " | visitas " << stats.totalVisits
+                  << " | celdas " << stats.uniqueCells
+                  << " | " << agents.bytesPerAgent() << " B/agente\n";
+    };
+
+    runWith(1);
+    if (threads != 1) runWith(threads);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Benchmark de consultas por lote: BatchQuerySolver vs un AStarSolver por consulta
+// Uso: batch_query_bench [ancho] [alto] [consultas] [origenes] [hilos]
+#include "Grid.h"
+#include "AStarSolver.h"
+#include "BatchQuerySolver.h"
+
+#include "DFSAlgorithm.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 256;
+    int height = argc > 2 ? std::atoi(argv[2]) : 256;
+    int queryCount = argc > 3 ? std::atoi(argv[3]) : 20000;
+    int sourceCount = argc > 4 ? std::atoi(argv[4]) : 64;
+    int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+
+    if (width <= 0 || height <= 0 || queryCount <= 0 || sourceCount <= 0) {
+        std::cerr << "Uso: batch_query_bench [ancho] [alto] [consultas] [origenes] [hilos]\n";
+        return 1;
+    }
+
+    Grid grid(width, height);
+    DFSAlgorithm generator(grid);
+    generator.runToEnd();
+
+    // Ráfaga de consultas: pocos orígenes compartidos, metas aleatorias
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> distX(0, width - 1);
+    std::uniform_int_distribution<int> distY(0, height - 1);
+
+    std::vector<Coord> sources;
+    for (int i = 0; i < sourceCount; ++i) sources.push_back(Coord(distX(rng), distY(rng)));
+
+    std::vector<PathQuery> queries;
+    queries.reserve(queryCount);
+    std::uniform_int_distribution<int> pickSource(0, sourceCount - 1);
+    for (int i = 0; i < queryCount; ++i) {
+        queries.push_back({sources[pickSource(rng)], Coord(distX(rng), distY(rng))});
+    }
+
+    std::cout << "=== Batch Query Benchmark ===\n";
+    std::cout << "Laberinto: " << width << "x" << height
+              << " | Consultas: " << queryCount << " | Origenes: " << sourceCount << "\n";
+
+    BatchQuerySolver batch(grid, threads);
+
+    auto runBatch = [&](bool wantPaths) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::vector<QueryResult> results = batch.solve(queries, wantPaths);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> secs = t1 - t0;
+
+        long long checksum = 0;
+        for (const auto& r : results) checksum += r.distance;
+
+        std::cout << "Batch (" << (wantPaths ? "caminos" : "distancias") << ", "
+                  << batch.getThreadCount() << " hilos): "
+                  << static_cast<long long>(queryCount / secs.count()) << " consultas/s"
+                  << "  [checksum " << checksum << "]\n";
+        std::cout << "  " << batch.getSearchStats() << "\n";
+    };
+    runBatch(false);
+    runBatch(true);
+
+    // Línea base: un AStarSolver (con sus grids propios) por consulta
+    int baselineCount = std::min(queryCount, 2000);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    long long checksum = 0;
+    for (int i = 0; i < baselineCount; ++i) {
+        AStarSolver solver(grid, queries[i].start, queries[i].goal);
+        while (!solver.step()) {}
+        checksum += static_cast<long long>(solver.getSolution().size()) - 1;
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> secs = t1 - t0;
+    std::cout << "AStarSolver por consulta (" << baselineCount << " muestras): "
+              << static_cast<long long>(baselineCount / secs.count()) << " consultas/s"
+              << "  [checksum " << checksum << "]\n";
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Benchmark de recolectores en paralelo sobre un mismo ChallengeSystem
+// (modo concurrente): cada hilo corre un CollectorSolver y todos compiten
+// por los mismos tesoros. Verifica que cada tesoro lo reclame exactamente uno.
+// Antes, un chequeo de un solo recolector con dos tesoros inalcanzables.
+// Uso: collector_race_bench [ancho] [alto] [tesoros] [recolectores]
+#include "Grid.h"
+#include "ChallengeSystem.h"
+#include "CollectorSolver.h"
+
+#include "DFSAlgorithm.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct RaceResult {
+    double seconds = 0.0;
+    std::vector<int> claims;     // Tesoros reclamados por cada recolector
+    int snapshots = 0;           // Fotos de snapshotRemaining() tomadas durante la carrera
+    bool monotonic = true;       // Cada foto contenida en la anterior
+    int nearGoalAtStart = 0;     // treasuresWithinRadius() alrededor de la meta
+};
+
+static bool check(bool ok, const char* what) {
+    if (!ok) std::cerr << "FALLA: " << what << "\n";
+    return ok;
+}
+
+// Peine: fila 0..H-1 abierta de x=0 a x=W-3, unidas por la columna 0. Las dos
+// últimas columnas quedan aisladas salvo un bolsillo de dos celdas en la fila
+// 1 con un tesoro cada una. Con más de 64 tesoros el solver usa el modo "más
+// cercano": debe terminar, juntar todo lo alcanzable y dejar el bolsillo
+static bool checkUnreachableTreasures() {
+    const int W = 24, H = 20;
+    Grid grid(W, H);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W - 3; ++x) grid.removeWall(y, x, 2);
+        if (y < H - 1) grid.removeWall(y, 0, 3);
+    }
+    grid.removeWall(1, W - 2, 2);
+    const Coord pocket[2] = {Coord(W - 2, 1), Coord(W - 1, 1)};
+
+    ChallengeSystem base(grid);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> rx(0, W - 3), ry(0, H - 1);
+    while (base.remainingTreasures() < 90) base.placeTreasureAt(Coord(rx(rng), ry(rng)));
+    for (const Coord& c : pocket) base.placeTreasureAt(c);
+    const int reachable = base.remainingTreasures() - 2;
+
+    bool ok = true;
+    const SolverStrategy strategies[] = {SolverStrategy::ASTAR, SolverStrategy::GREEDY, SolverStrategy::UCS,
+                                         SolverStrategy::DFS, SolverStrategy::DEADEND_FILL};
+    for (SolverStrategy strategy : strategies) {
+        ChallengeSystem challenges(base);
+        CollectorSolver solver(grid, challenges, Coord(0, 0), Coord(W / 2, H / 2), strategy);
+        long long steps = 0;
+        const long long maxSteps = 1000000;
+        while (!solver.finished() && steps < maxSteps) {
+            solver.step();
+            ++steps;
+        }
+        ok &= check(solver.finished(), "el solver no termina con tesoros inalcanzables");
+        ok &= check(solver.getTreasuresCollected() == reachable, "no juntó todos los tesoros alcanzables");
+        ok &= check(challenges.hasTreasure(pocket[0]) && challenges.hasTreasure(pocket[1]),
+                    "tesoros inalcanzables marcados como recolectados");
+    }
+    std::cout << "Tesoros inalcanzables: " << (ok ? "OK" : "ERROR") << " (" << reachable
+              << " alcanzables + 2 en un bolsillo aislado, 5 estrategias)\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 256;
+    int height = argc > 2 ? std::atoi(argv[2]) : 256;
+    int treasureCount = argc > 3 ? std::atoi(argv[3]) : 4000;
+    int collectorCount = argc > 4 ? std::atoi(argv[4]) : 8;
+
+    if (width < 4 || height < 4 || treasureCount <= 0 || collectorCount <= 0) {
+        std::cerr << "Uso: collector_race_bench [ancho] [alto] [tesoros] [recolectores]\n";
+        return 1;
+    }
+
+    Grid grid(width, height);
+    DFSAlgorithm generator(grid);
+    generator.runToEnd();
+
+    // Tesoros y puntos de partida fijos (el mismo mapa para cada corrida)
+    ChallengeSystem base(grid);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> rx(0, width - 1), ry(0, height - 1);
+    for (int attempts = 0; base.remainingTreasures() < treasureCount && attempts < treasureCount * 8; ++attempts) {
+        base.placeTreasureAt(Coord(rx(rng), ry(rng)));
+    }
+    const int placed = base.remainingTreasures();
+
+    std::vector<Coord> starts;
+    for (int i = 0; i < collectorCount; ++i) starts.push_back(Coord(rx(rng), ry(rng)));
+    const Coord goal(width / 2, height / 2);
+    const int nearRadius = (width + height) / 8;
+
+    std::cout << "=== Collector Race Benchmark ===\n";
+    std::cout << "Laberinto: " << width << "x" << height << " | Tesoros: " << placed
+              << " | Recolectores: " << collectorCount << "\n";
+
+    bool ok = checkUnreachableTreasures();
+
+    auto race = [&](int collectors) {
+        RaceResult result;
+        ChallengeSystem challenges(base);
+        challenges.setConcurrentMode(true);
+
+        // Antes de largar: el índice y el bitmap ven los mismos tesoros
+        ok &= check(static_cast<int>(challenges.snapshotRemaining().size()) == placed,
+                    "snapshotRemaining() inicial != tesoros colocados");
+        ok &= check(static_cast<int>(challenges.treasuresWithinRadius(goal, width + height).size()) == placed,
+                    "treasuresWithinRadius() sobre todo el mapa != tesoros colocados");
+        result.nearGoalAtStart = static_cast<int>(challenges.treasuresWithinRadius(goal, nearRadius).size());
+
+        // Los solvers se arman en este hilo (leen los tesoros para planificar)
+        std::vector<std::unique_ptr<CollectorSolver>> solvers;
+        for (int i = 0; i < collectors; ++i) {
+            solvers.push_back(std::make_unique<CollectorSolver>(grid, challenges, starts[i], goal, SolverStrategy::ASTAR));
+        }
+
+        std::atomic<int> running{collectors};
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < collectors; ++i) {
+            threads.emplace_back([&, i] {
+                CollectorSolver& solver = *solvers[i];
+                while (!solver.finished()) solver.step();
+                running.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        // Monitor: fotos sin locks mientras corren. Los bits solo se apagan,
+        // así que cada foto debe estar contenida en la anterior
+        std::vector<char> previous(static_cast<size_t>(width) * height, 1);
+        while (running.load(std::memory_order_acquire) > 0) {
+            std::vector<char> current(previous.size(), 0);
+            for (const Coord& c : challenges.snapshotRemaining()) {
+                size_t id = static_cast<size_t>(c.y) * width + c.x;
+                if (!previous[id]) result.monotonic = false;
+                current[id] = 1;
+            }
+            previous.swap(current);
+            result.snapshots++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        for (auto& t : threads) t.join();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        int claimed = 0;
+        for (const auto& solver : solvers) {
+            result.claims.push_back(solver->getTreasuresCollected());
+            claimed += solver->getTreasuresCollected();
+        }
+
+        // Solo collectTreasure() apaga bits y cada reclamo exitoso suma 1 a un
+        // solo recolector: con el mapa vacío y tantos reclamos como tesoros,
+        // cada tesoro fue reclamado exactamente una vez
+        ok &= check(claimed == placed, "suma de reclamos != tesoros colocados");
+        ok &= check(challenges.getCollectedCount() == placed, "getCollectedCount() != tesoros colocados");
+        ok &= check(challenges.snapshotRemaining().empty(), "quedaron tesoros en el bitmap");
+        ok &= check(result.monotonic, "snapshotRemaining() no fue monótona durante la carrera");
+
+        // En modo concurrente las cubetas siguen sucias: la consulta debe saltar lo reclamado
+        ok &= check(challenges.treasuresWithinRadius(goal, width + height).empty(),
+                    "treasuresWithinRadius() devolvió tesoros reclamados");
+        challenges.setConcurrentMode(false);
+        ok &= check(!challenges.nearestTreasure(goal).has_value(), "nearestTreasure() tras compactar");
+
+        std::cout << collectors << " recolectores: " << result.seconds * 1000.0 << " ms"
+                  << " | fotos " << result.snapshots
+                  << " | cerca de la meta al inicio " << result.nearGoalAtStart
+                  << " | reclamos";
+        for (int c : result.claims) std::cout << " " << c;
+        std::cout << "\n";
+    };
+
+    race(1);
+    if (collectorCount != 1) race(collectorCount);
+
+    std::cout << (ok ? "OK: cada tesoro reclamado exactamente una vez\n" : "ERROR\n");
+    return ok ? 0 : 1;
+}
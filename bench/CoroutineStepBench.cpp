@@ -0,0 +1,157 @@
+// Benchmark: costo por paso de generadores con step() (máquina de estados)
+// vs la misma generación escrita como corrutina. Lo mismo para los solvers:
+// AStarSolver (máquina de estados) vs CollectorSolver (corrutina) sin tesoros
+// Uso: coroutine_step_bench [ancho] [alto] [repeticiones]
+#include "Grid.h"
+#include "MazeAlgorithm.h"
+#include "AStarSolver.h"
+#include "ChallengeSystem.h"
+#include "CollectorSolver.h"
+
+#include "DFSAlgorithm.cpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+// Línea base: el DFSAlgorithm anterior (máquina de estados explícita)
+struct StateMachineDFS : public MazeAlgorithm {
+    Grid &g;
+    std::stack<Coord> path;
+    bool done = false;
+
+    StateMachineDFS(Grid &grid) : g(grid) {
+        Coord start(std::rand() % g.width(), std::rand() % g.height());
+        path.push(start);
+        g.at(start.x, start.y).visited = true;
+    }
+
+    bool step() override {
+        if (done) return true;
+        if (path.empty()) { done = true; return true; }
+
+        Coord cur = path.top();
+        int x = cur.x, y = cur.y;
+        int dir = g.pickRandomNeighborDir(x, y);
+        if (dir == -1) {
+            path.pop();
+        } else {
+            int nx = x, ny = y;
+            if (dir == 0) ny = y - 1;
+            else if (dir == 1) nx = x - 1;
+            else if (dir == 2) nx = x + 1;
+            else if (dir == 3) ny = y + 1;
+
+            g.removeWall(y, x, static_cast<short>(dir));
+            g.at(nx, ny).visited = true;
+            path.push(Coord(nx, ny));
+        }
+
+        if (path.empty()) done = true;
+        return done;
+    }
+
+    bool finished() const override { return done; }
+};
+
+template <typename Body>
+void runCase(const std::string &name, int width, int height, int reps, Body body) {
+    long long events = 0;
+    std::uint64_t checksum = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        Grid grid(width, height);
+        events += body(grid);
+        checksum += grid.wallHash();
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> secs = t1 - t0;
+
+    std::cout << name << ": " << secs.count() * 1000.0 / reps << " ms/laberinto, "
+              << secs.count() * 1e9 / static_cast<double>(events) << " ns/evento"
+              << "  [hash " << std::hex << checksum << std::dec << "]\n";
+}
+
+// Los laberintos se generan antes de medir; cada solver va de (0,0) a la
+// esquina opuesta. El checksum (suma de largos de camino) debe coincidir
+template <typename Solve>
+void runSolverCase(const std::string &name, std::vector<Grid> &mazes, Solve solve) {
+    long long events = 0;
+    std::uint64_t checksum = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (Grid &grid : mazes) events += solve(grid, checksum);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> secs = t1 - t0;
+
+    std::cout << name << ": " << secs.count() * 1000.0 / mazes.size() << " ms/laberinto, "
+              << secs.count() * 1e9 / static_cast<double>(events) << " ns/expansion"
+              << "  [camino " << checksum << "]\n";
+}
+
+int main(int argc, char **argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 200;
+    int height = argc > 2 ? std::atoi(argv[2]) : 200;
+    int reps = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    if (width <= 0 || height <= 0 || reps <= 0) {
+        std::cerr << "Uso: coroutine_step_bench [ancho] [alto] [repeticiones]\n";
+        return 1;
+    }
+
+    std::cout << "=== Coroutine vs step() Benchmark ===\n";
+    std::cout << "Laberinto: " << width << "x" << height << " | Repeticiones: " << reps << "\n";
+
+    // Máquina de estados, una llamada virtual por paso (modo visual de antes)
+    runCase("step() maquina de estados", width, height, reps, [](Grid &grid) {
+        std::unique_ptr<MazeAlgorithm> algo(new StateMachineDFS(grid));
+        long long n = 0;
+        while (!algo->finished()) { algo->step(); ++n; }
+        return n;
+    });
+
+    // Corrutina detrás de la interfaz virtual (modo visual actual)
+    runCase("step() corrutina", width, height, reps, [](Grid &grid) {
+        std::unique_ptr<MazeAlgorithm> algo(new DFSAlgorithm(grid));
+        long long n = 0;
+        while (!algo->finished()) { algo->step(); ++n; }
+        return n;
+    });
+
+    // Corrutina sin interfaz virtual: range-for sobre los eventos (modo headless)
+    runCase("range-for corrutina", width, height, reps, [](Grid &grid) {
+        long long n = 0;
+        for (const Coord &c : DFSAlgorithm::generate(grid)) { (void)c; ++n; }
+        return n;
+    });
+
+    std::vector<Grid> mazes;
+    for (int r = 0; r < reps; ++r) {
+        mazes.emplace_back(width, height);
+        DFSAlgorithm(mazes.back()).runToEnd();
+    }
+    const Coord start(0, 0), goal(width - 1, height - 1);
+
+    // Solver con step() de máquina de estados (una búsqueda A*)
+    runSolverCase("A* step() maquina de estados", mazes, [&](Grid &grid, std::uint64_t &checksum) {
+        AStarSolver solver(grid, start, goal);
+        while (!solver.finished()) solver.step();
+        checksum += solver.getSolution().size();
+        return solver.getSearchStats().pops;
+    });
+
+    // Recolector sin tesoros: la misma búsqueda A* como un único tramo de la corrutina
+    // (además registra el heatmap y busca tesoros de paso en cada expansión)
+    runSolverCase("A* step() corrutina (CollectorSolver)", mazes, [&](Grid &grid, std::uint64_t &checksum) {
+        ChallengeSystem challenges(grid);
+        CollectorSolver solver(grid, challenges, start, goal, SolverStrategy::ASTAR);
+        while (!solver.finished()) solver.step();
+        checksum += solver.getFullPath().size();
+        return solver.getSearchStats().pops;
+    });
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+// Benchmark headless: matriz generador x solver x tamaño, sin SFML
+// Uso: maze_bench [--sizes 40x28,80x60] [--generators DFS,Prim's] [--solvers A*,UCS]
+//                 [--iterations N] [--threads N] [--seed N] [--format text|csv|json] [--out archivo]
+#include "AlgorithmRankingAVL.h"
+#include "BenchmarkRunner.h"
+#include "BenchmarkScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchRow {
+    std::string generator;
+    std::string solver;
+    int width;
+    int height;
+    AlgorithmStats summary;
+};
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool parseSize(const std::string& text, int& w, int& h) {
+    size_t sep = text.find('x');
+    if (sep == std::string::npos) return false;
+    w = std::atoi(text.substr(0, sep).c_str());
+    h = std::atoi(text.substr(sep + 1).c_str());
+    return w > 1 && h > 1;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"") == std::string::npos) return text;
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void writeCsv(std::ostream& out, const std::vector<BenchRow>& rows) {
+    out << "generator,solver,width,height,runs,score,"
+           "nodes_mean,nodes_stddev,nodes_p50,nodes_p95,nodes_p99,"
+           "time_ms_mean,time_ms_stddev,time_ms_p50,time_ms_p95,time_ms_p99,"
+           "path_mean,treasures_mean\n";
+    for (const BenchRow& r : rows) {
+        const AlgorithmStats& s = r.summary;
+        out << csvField(r.generator) << ',' << csvField(r.solver) << ',' << r.width << ',' << r.height << ','
+            << s.nodesDist.runs << ',' << s.calculateScore() << ','
+            << s.nodesDist.mean << ',' << s.nodesDist.stdDev << ',' << s.nodesDist.p50 << ','
+            << s.nodesDist.p95 << ',' << s.nodesDist.p99 << ','
+            << s.timeDist.mean * 1000.0f << ',' << s.timeDist.stdDev * 1000.0f << ',' << s.timeDist.p50 * 1000.0f << ','
+            << s.timeDist.p95 * 1000.0f << ',' << s.timeDist.p99 * 1000.0f << ','
+            << s.pathLength << ',' << s.treasuresCollected << '\n';
+    }
+}
+
+void writeJson(std::ostream& out, const std::vector<BenchRow>& rows, int iterations, unsigned seed) {
+    auto dist = [&](const RunDistribution& d, float scale) {
+        std::ostringstream os;
+        os << "{\"mean\": " << d.mean * scale << ", \"stddev\": " << d.stdDev * scale
+           << ", \"p50\": " << d.p50 * scale << ", \"p95\": " << d.p95 * scale << ", \"p99\": " << d.p99 * scale << "}";
+        return os.str();
+    };
+
+    out << "{\n  \"iterations\": " << iterations << ",\n  \"seed\": " << seed << ",\n  \"results\": [";
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const BenchRow& r = rows[i];
+        const AlgorithmStats& s = r.summary;
+        out << (i ? ",\n" : "\n")
+            << "    {\"generator\": \"" << jsonEscape(r.generator) << "\", \"solver\": \"" << jsonEscape(r.solver)
+            << "\", \"width\": " << r.width << ", \"height\": " << r.height
+            << ", \"runs\": " << s.nodesDist.runs << ", \"score\": " << s.calculateScore()
+            << ", \"nodes\": " << dist(s.nodesDist, 1.0f)
+            << ", \"time_ms\": " << dist(s.timeDist, 1000.0f)
+            << ", \"path_mean\": " << s.pathLength << ", \"treasures_mean\": " << s.treasuresCollected << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeText(std::ostream& out, const std::vector<BenchRow>& rows) {
+    out << std::left << std::setw(11) << "Generador" << std::setw(15) << "Solver" << std::setw(9) << "Tamaño"
+        << std::right << std::setw(8) << "Score" << std::setw(12) << "Nodos p50" << std::setw(12) << "Nodos p95"
+        << std::setw(14) << "Tiempo p50" << std::setw(14) << "Tiempo p95" << "\n";
+    out << std::fixed << std::setprecision(3);
+    for (const BenchRow& r : rows) {
+        const AlgorithmStats& s = r.summary;
+        out << std::left << std::setw(11) << r.generator << std::setw(15) << r.solver
+            << std::setw(9) << (std::to_string(r.width) + "x" + std::to_string(r.height))
+            << std::right << std::setw(8) << static_cast<int>(s.calculateScore())
+            << std::setw(12) << static_cast<int>(s.nodesDist.p50) << std::setw(12) << static_cast<int>(s.nodesDist.p95)
+            << std::setw(11) << s.timeDist.p50 * 1000.0f << " ms" << std::setw(11) << s.timeDist.p95 * 1000.0f << " ms\n";
+    }
+}
+
+void printUsage() {
+    std::cerr << "Uso: maze_bench [--sizes 40x28,80x60] [--generators DFS,Prim's,Hunt&Kill,Kruskal's]\n"
+                 "                [--solvers A*,Greedy,UCS,DFS,Dead-End Fill] [--iterations N]\n"
+                 "                [--threads N (0 = todos)] [--seed N] [--format text|csv|json] [--out archivo]\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::pair<int, int>> sizes = {{40, 28}};
+    std::vector<std::string> generators = benchmarkGenerators();
+    std::vector<std::string> solverNames;
+    for (const auto& solver : benchmarkSolvers()) solverNames.push_back(solver.second);
+    int iterations = 30;
+    int threads = 0;
+    unsigned seed = static_cast<unsigned>(std::time(nullptr));
+    std::string format = "text";
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--sizes") {
+            sizes.clear();
+            for (const std::string& item : splitList(value)) {
+                int w = 0, h = 0;
+                if (!parseSize(item, w, h)) {
+                    std::cerr << "Tamaño inválido: " << item << "\n";
+                    return 1;
+                }
+                sizes.emplace_back(w, h);
+            }
+        } else if (arg == "--generators") {
+            generators = splitList(value);
+        } else if (arg == "--solvers") {
+            solverNames = splitList(value);
+        } else if (arg == "--iterations") {
+            iterations = std::atoi(value.c_str());
+        } else if (arg == "--threads") {
+            threads = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--format") {
+            format = value;
+        } else if (arg == "--out") {
+            outPath = value;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (iterations <= 0 || threads < 0 || sizes.empty() || generators.empty() || solverNames.empty() ||
+        (format != "text" && format != "csv" && format != "json")) {
+        printUsage();
+        return 1;
+    }
+
+    // Validar nombres contra las listas del ranking
+    for (const std::string& gen : generators) {
+        const auto& known = benchmarkGenerators();
+        if (std::find(known.begin(), known.end(), gen) == known.end()) {
+            std::cerr << "Generador desconocido: " << gen << "\n";
+            return 1;
+        }
+    }
+    std::vector<std::pair<SolverStrategy, std::string>> solvers;
+    for (const std::string& name : solverNames) {
+        bool found = false;
+        for (const auto& solver : benchmarkSolvers()) {
+            if (solver.second == name) {
+                solvers.push_back(solver);
+                found = true;
+            }
+        }
+        if (!found) {
+            std::cerr << "Solver desconocido: " << name << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchRow> rows;
+    for (const auto& [w, h] : sizes) {
+        BenchmarkConfig config;
+        config.generators = generators;
+        config.solvers = solvers;
+        config.iterations = iterations;
+        config.width = w;
+        config.height = h;
+        config.baseSeed = seed;
+        config.threadCount = threads;
+        BenchmarkScheduler scheduler(config);
+
+        // Agregación en orden fijo: el resultado no depende de la cantidad de hilos
+        std::vector<AlgorithmStatsAccumulator> accs(generators.size() * solvers.size());
+        for (const BenchmarkResult& r : scheduler.run()) {
+            accs[r.generator * solvers.size() + r.solver].add(r.stats);
+        }
+
+        for (size_t g = 0; g < generators.size(); ++g) {
+            for (size_t s = 0; s < solvers.size(); ++s) {
+                const std::string& solverName = solvers[s].second;
+                rows.push_back({generators[g], solverName, w, h, accs[g * solvers.size() + s].summarize(solverName)});
+            }
+        }
+        std::cerr << "  " << w << "x" << h << " OK  generación " << scheduler.getLastGenerateSeconds() * 1000.0
+                  << " ms, resolución " << scheduler.getLastSolveSeconds() * 1000.0 << " ms ("
+                  << scheduler.getThreadCount() << " hilos, " << scheduler.getLastSteals() << " robos)\n";
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) {
+        file.open(outPath);
+        if (!file) {
+            std::cerr << "No se pudo abrir " << outPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    if (format == "csv") writeCsv(out, rows);
+    else if (format == "json") writeJson(out, rows, iterations, seed);
+    else writeText(out, rows);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Benchmark del ranking AVL (arena de nodos + nombres internados)
+// Uso: ranking_bench [entradas] [actualizaciones]
+#include "AlgorithmRankingAVL.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    int entryCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int updateCount = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    if (entryCount <= 0 || updateCount < 0) {
+        std::cerr << "Uso: ranking_bench [entradas] [actualizaciones]\n";
+        return 1;
+    }
+
+    // Entradas sintéticas: nombres distintos, métricas aleatorias
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> nodesDist(0, 1000);
+    std::uniform_int_distribution<int> treasureDist(0, 3);
+    std::uniform_real_distribution<float> timeDist(0.0f, 0.2f);
+
+    auto randomStats = [&](const std::string& name) {
+        AlgorithmStats s;
+        s.algorithmName = name;
+        s.nodesExpanded = nodesDist(rng);
+        s.executionTime = timeDist(rng);
+        s.treasuresCollected = treasureDist(rng);
+        return s;
+    };
+
+    std::vector<AlgorithmStats> entries;
+    entries.reserve(entryCount);
+    for (int i = 0; i < entryCount; ++i) entries.push_back(randomStats("solver_" + std::to_string(i)));
+
+    std::cout << "=== Ranking AVL Benchmark ===\n";
+    std::cout << "Entradas: " << entryCount << " | Actualizaciones: " << updateCount << "\n";
+
+    AlgorithmRankingAVL ranking;
+    auto seconds = [](auto t0, auto t1) { return std::chrono::duration<double>(t1 - t0).count(); };
+
+    // Dos rondas: la segunda reutiliza la arena y los nombres tras clear()
+    for (int round = 1; round <= 2; ++round) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (const AlgorithmStats& s : entries) ranking.insert(s);
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        std::uniform_int_distribution<int> pick(0, entryCount - 1);
+        std::vector<AlgorithmStats> updates;
+        updates.reserve(updateCount);
+        for (int i = 0; i < updateCount; ++i) updates.push_back(randomStats(entries[pick(rng)].algorithmName));
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (const AlgorithmStats& s : updates) ranking.update(s.algorithmName, s);
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        // Lecturas paginadas y consultas de ranking
+        long long checksum = 0;
+        for (int i = 0; i < 1000; ++i) {
+            std::vector<RankEntry> page = ranking.getRange(pick(rng) + 1, 20);
+            checksum += page.size();
+            checksum += ranking.rankOf(entries[pick(rng)].algorithmName);
+        }
+        auto t4 = std::chrono::high_resolution_clock::now();
+
+        ranking.clear();
+        auto t5 = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Ronda " << round << ": insert "
+                  << static_cast<long long>(entryCount / seconds(t0, t1)) << " ops/s"
+                  << " | update " << static_cast<long long>(updateCount / seconds(t2, t3)) << " ops/s"
+                  << " | 1000x(getRange 20 + rankOf) " << seconds(t3, t4) * 1000.0 << " ms"
+                  << " | clear " << seconds(t4, t5) * 1e6 << " us"
+                  << "  [checksum " << checksum << "]\n";
+    }
+
+    std::cout << "Memoria: " << ranking.bytesUsed() / (1024 * 1024) << " MiB"
+              << " (" << ranking.bytesUsed() / entryCount << " B/entrada)\n";
+
+    return 0;
+}
@@ -0,0 +1,379 @@
+// Barrido de escalado: tiempo (y nodos expandidos) de generadores y solvers
+// frente al tamaño del laberinto, con ajuste a N, N log N y N² (N = celdas).
+// Uso: scaling_bench [--min 16] [--max 8192] [--generators DFS,Prim's] [--solvers A*,UCS]
+//                    [--solver-maze DFS] [--seeds 3] [--warmup 1] [--seed N]
+//                    [--budget segundos] [--fit-min 64] [--out scaling.json]
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Point {
+    int side;
+    double cells;
+    double seconds;     // Mediana entre seeds
+    double expansions;  // Mediana entre seeds (solo solvers)
+};
+
+struct Series {
+    std::string kind;  // "generator" | "solver"
+    std::string name;
+    std::vector<Point> points;
+    bool truncated = false;  // Se cortó el barrido por el presupuesto de tiempo
+    int truncatedAt = 0;     // Primer lado no medido
+};
+
+struct ModelFit {
+    std::string model;
+    double coefficient = 0.0;
+    double rmsRelError = 0.0;
+};
+
+struct Fit {
+    bool valid = false;
+    std::vector<ModelFit> models;  // N, N log N, N²
+    std::string best;
+    double exponent = 0.0;  // Pendiente log-log
+    bool superlinear = false;
+};
+
+const double SUPERLINEAR_EXPONENT = 1.2;  // N log N en este rango da ~1.1
+
+double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+// Ajuste y ≈ c·f(N) minimizando el error relativo (los valores cubren varios
+// órdenes de magnitud) y pendiente de log y contra log N
+Fit fitComplexity(const std::vector<Point>& points, int fitMinSide, bool useExpansions) {
+    std::vector<std::pair<double, double>> xy;
+    for (const Point& p : points) {
+        double y = useExpansions ? p.expansions : p.seconds;
+        if (p.side >= fitMinSide && y > 0.0) xy.emplace_back(p.cells, y);
+    }
+    // Pocos puntos sobre el umbral: usar todos
+    if (xy.size() < 3) {
+        xy.clear();
+        for (const Point& p : points) {
+            double y = useExpansions ? p.expansions : p.seconds;
+            if (y > 0.0) xy.emplace_back(p.cells, y);
+        }
+    }
+
+    Fit fit;
+    if (xy.size() < 3) return fit;
+    fit.valid = true;
+
+    struct Model {
+        const char* name;
+        double (*f)(double);
+    };
+    const Model models[] = {
+        {"N", [](double n) { return n; }},
+        {"N log N", [](double n) { return n * std::log2(n); }},
+        {"N^2", [](double n) { return n * n; }},
+    };
+
+    double bestError = 0.0;
+    for (const Model& m : models) {
+        // min Σ ((y - c·f)/y)²  =>  c = Σ(f/y) / Σ(f/y)²
+        double num = 0.0, den = 0.0;
+        for (const auto& [n, y] : xy) {
+            double r = m.f(n) / y;
+            num += r;
+            den += r * r;
+        }
+        ModelFit mf;
+        mf.model = m.name;
+        mf.coefficient = den > 0.0 ? num / den : 0.0;
+
+        double err = 0.0;
+        for (const auto& [n, y] : xy) {
+            double rel = (y - mf.coefficient * m.f(n)) / y;
+            err += rel * rel;
+        }
+        mf.rmsRelError = std::sqrt(err / static_cast<double>(xy.size()));
+
+        if (fit.models.empty() || mf.rmsRelError < bestError) {
+            bestError = mf.rmsRelError;
+            fit.best = mf.model;
+        }
+        fit.models.push_back(mf);
+    }
+
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for (const auto& [n, y] : xy) {
+        double lx = std::log(n), ly = std::log(y);
+        sx += lx;
+        sy += ly;
+        sxx += lx * lx;
+        sxy += lx * ly;
+    }
+    double k = static_cast<double>(xy.size());
+    double denom = k * sxx - sx * sx;
+    fit.exponent = denom != 0.0 ? (k * sxy - sx * sy) / denom : 0.0;
+    fit.superlinear = fit.exponent > SUPERLINEAR_EXPONENT || fit.best == "N^2";
+    return fit;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string fitJson(const Fit& fit) {
+    if (!fit.valid) return "null";
+    std::ostringstream os;
+    os << "{\"best\": \"" << fit.best << "\", \"exponent\": " << fit.exponent
+       << ", \"superlinear\": " << (fit.superlinear ? "true" : "false") << ", \"models\": [";
+    for (size_t i = 0; i < fit.models.size(); ++i) {
+        const ModelFit& m = fit.models[i];
+        os << (i ? ", " : "") << "{\"model\": \"" << m.model << "\", \"coefficient\": " << m.coefficient
+           << ", \"rms_rel_error\": " << m.rmsRelError << "}";
+    }
+    os << "]}";
+    return os.str();
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+void printUsage() {
+    std::cerr << "Uso: scaling_bench [--min 16] [--max 8192] [--generators DFS,Prim's,Hunt&Kill,Kruskal's]\n"
+                 "                    [--solvers A*,Greedy,UCS,DFS,Dead-End Fill] [--solver-maze DFS]\n"
+                 "                    [--seeds 3] [--warmup 1] [--seed N] [--budget segundos]\n"
+                 "                    [--fit-min 64] [--out scaling.json]\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int minSide = 16;
+    int maxSide = 8192;
+    std::vector<std::string> generators = benchmarkGenerators();
+    std::vector<std::string> solverNames;
+    for (const auto& solver : benchmarkSolvers()) solverNames.push_back(solver.second);
+    std::string solverMaze = "DFS";
+    int seeds = 3;
+    int warmup = 1;
+    unsigned baseSeed = static_cast<unsigned>(std::time(nullptr));
+    double budget = 10.0;  // Segundos por corrida estimados: por encima, se corta el barrido
+    int fitMinSide = 64;
+    std::string outPath = "scaling.json";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--min") minSide = std::atoi(value.c_str());
+        else if (arg == "--max") maxSide = std::atoi(value.c_str());
+        else if (arg == "--generators") generators = splitList(value);
+        else if (arg == "--solvers") solverNames = splitList(value);
+        else if (arg == "--solver-maze") solverMaze = value;
+        else if (arg == "--seeds") seeds = std::atoi(value.c_str());
+        else if (arg == "--warmup") warmup = std::atoi(value.c_str());
+        else if (arg == "--seed") baseSeed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--budget") budget = std::atof(value.c_str());
+        else if (arg == "--fit-min") fitMinSide = std::atoi(value.c_str());
+        else if (arg == "--out") outPath = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (minSide < 2 || maxSide < minSide || seeds <= 0 || warmup < 0 || budget <= 0.0) {
+        printUsage();
+        return 1;
+    }
+
+    // Validar nombres contra las listas del ranking
+    const auto& knownGens = benchmarkGenerators();
+    for (const std::string& gen : generators) {
+        if (std::find(knownGens.begin(), knownGens.end(), gen) == knownGens.end()) {
+            std::cerr << "Generador desconocido: " << gen << "\n";
+            return 1;
+        }
+    }
+    if (std::find(knownGens.begin(), knownGens.end(), solverMaze) == knownGens.end()) {
+        std::cerr << "Generador desconocido: " << solverMaze << "\n";
+        return 1;
+    }
+    std::vector<std::pair<SolverStrategy, std::string>> solvers;
+    for (const std::string& name : solverNames) {
+        bool found = false;
+        for (const auto& solver : benchmarkSolvers()) {
+            if (solver.second == name) {
+                solvers.push_back(solver);
+                found = true;
+            }
+        }
+        if (!found) {
+            std::cerr << "Solver desconocido: " << name << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<int> sides;
+    for (long long side = minSide; side <= maxSide; side *= 2) sides.push_back(static_cast<int>(side));
+
+    std::vector<Series> genSeries;
+    for (const std::string& gen : generators) genSeries.push_back({"generator", gen, {}, false, 0});
+    std::vector<Series> solverSeries;
+    for (const auto& solver : solvers) solverSeries.push_back({"solver", solver.second, {}, false, 0});
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point t0, Clock::time_point t1) {
+        return std::chrono::duration<double>(t1 - t0).count();
+    };
+    // No medir el tamaño siguiente si, extrapolando el último crecimiento (como
+    // mínimo lineal: el doble de lado son 4x celdas), superaría el presupuesto
+    auto checkBudget = [&](Series& series) {
+        const std::vector<Point>& pts = series.points;
+        double t = pts.back().seconds;
+        double next = t * 4.0;
+        if (pts.size() >= 2 && pts[pts.size() - 2].seconds > 0.0) {
+            next = std::max(next, t * t / pts[pts.size() - 2].seconds);
+        }
+        if (next > budget) {
+            series.truncated = true;
+            series.truncatedAt = pts.back().side * 2;
+        }
+    };
+    auto seedFor = [&](int side, int k) { return baseSeed + static_cast<unsigned>(side) * 7919u + static_cast<unsigned>(k); };
+
+    for (int side : sides) {
+        double cells = static_cast<double>(side) * side;
+        std::cerr << side << "x" << side << "\n";
+
+        // Generadores: tiempo de reserva + generación completa (incluye colocar tesoros)
+        for (Series& series : genSeries) {
+            if (series.truncated) continue;
+            for (int w = 0; w < warmup; ++w) prepareBenchmarkMaze(series.name, side, side, seedFor(side, -1 - w));
+
+            std::vector<double> times;
+            for (int k = 0; k < seeds; ++k) {
+                auto t0 = Clock::now();
+                PreparedMaze maze = prepareBenchmarkMaze(series.name, side, side, seedFor(side, k));
+                times.push_back(seconds(t0, Clock::now()));
+            }
+            series.points.push_back({side, cells, median(times), 0.0});
+            std::cerr << "  gen " << series.name << ": " << median(times) * 1000.0 << " ms\n";
+            checkBudget(series);
+        }
+
+        // Solvers: un laberinto por seed (se libera antes del siguiente: a 8192x8192
+        // cada laberinto + estado del solver ocupa cientos de MB)
+        bool anySolver = std::any_of(solverSeries.begin(), solverSeries.end(), [](const Series& s) { return !s.truncated; });
+        // Si el generador de los laberintos de prueba ya quedó fuera de presupuesto, tampoco se generan
+        for (const Series& g : genSeries) {
+            if (g.name == solverMaze && g.truncated && g.truncatedAt <= side) anySolver = false;
+        }
+        if (!anySolver) continue;
+
+        std::vector<std::vector<double>> times(solvers.size()), expansions(solvers.size());
+        for (int k = 0; k < seeds; ++k) {
+            PreparedMaze maze = prepareBenchmarkMaze(solverMaze, side, side, seedFor(side, k));
+            for (size_t s = 0; s < solvers.size(); ++s) {
+                if (solverSeries[s].truncated) continue;
+                if (k == 0) {
+                    for (int w = 0; w < warmup; ++w) solvePreparedMaze(maze, solvers[s].first, solvers[s].second);
+                }
+                AlgorithmStats stats = solvePreparedMaze(maze, solvers[s].first, solvers[s].second);
+                times[s].push_back(stats.executionTime);
+                expansions[s].push_back(stats.nodesExpanded);
+            }
+        }
+        for (size_t s = 0; s < solvers.size(); ++s) {
+            Series& series = solverSeries[s];
+            if (series.truncated) continue;
+            double t = median(times[s]);
+            series.points.push_back({side, cells, t, median(expansions[s])});
+            std::cerr << "  solve " << series.name << ": " << t * 1000.0 << " ms, " << median(expansions[s]) << " nodos\n";
+            checkBudget(series);
+        }
+    }
+
+    // Reporte
+    std::vector<const Series*> all;
+    for (const Series& s : genSeries) all.push_back(&s);
+    for (const Series& s : solverSeries) all.push_back(&s);
+
+    std::ofstream out(outPath);
+    if (!out) {
+        std::cerr << "No se pudo abrir " << outPath << "\n";
+        return 1;
+    }
+    out << "{\n  \"seed\": " << baseSeed << ", \"seeds\": " << seeds << ", \"warmup\": " << warmup
+        << ", \"budget_s\": " << budget << ", \"fit_min_side\": " << fitMinSide
+        << ", \"solver_maze\": \"" << jsonEscape(solverMaze) << "\",\n  \"series\": [";
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Series& s = *all[i];
+        bool isSolver = s.kind == "solver";
+        out << (i ? ",\n" : "\n") << "    {\"kind\": \"" << s.kind << "\", \"name\": \"" << jsonEscape(s.name)
+            << "\", \"truncated_at\": " << (s.truncated && s.truncatedAt <= maxSide ? s.truncatedAt : 0)
+            << ",\n     \"points\": [";
+        for (size_t p = 0; p < s.points.size(); ++p) {
+            const Point& pt = s.points[p];
+            out << (p ? ", " : "") << "{\"side\": " << pt.side << ", \"cells\": " << static_cast<long long>(pt.cells)
+                << ", \"time_s\": " << pt.seconds;
+            if (isSolver) out << ", \"expansions\": " << pt.expansions;
+            out << "}";
+        }
+        out << "],\n     \"time_fit\": " << fitJson(fitComplexity(s.points, fitMinSide, false));
+        if (isSolver) out << ",\n     \"expansions_fit\": " << fitJson(fitComplexity(s.points, fitMinSide, true));
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+
+    // Resumen en consola
+    std::cout << std::left << std::setw(11) << "Tipo" << std::setw(15) << "Nombre" << std::setw(11) << "Tiempo"
+              << std::setw(8) << "Exp." << std::setw(11) << "Nodos" << "Superlineal\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const Series* s : all) {
+        Fit timeFit = fitComplexity(s->points, fitMinSide, false);
+        Fit nodeFit = fitComplexity(s->points, fitMinSide, true);
+        bool isSolver = s->kind == "solver";
+        std::cout << std::left << std::setw(11) << s->kind << std::setw(15) << s->name
+                  << std::setw(11) << (timeFit.valid ? timeFit.best : "-") << std::setw(8) << timeFit.exponent
+                  << std::setw(11) << (isSolver && nodeFit.valid ? nodeFit.best : "-")
+                  << ((timeFit.superlinear || (isSolver && nodeFit.superlinear)) ? "SI" : "no");
+        if (s->truncated && s->truncatedAt <= maxSide) std::cout << "  (cortado en " << s->truncatedAt << ")";
+        std::cout << "\n";
+    }
+    std::cerr << "Reporte: " << outPath << "\n";
+    return 0;
+}
@@ -2,13 +2,17 @@
 #define ASTAR_SOLVER_H
 
 #include "Grid.h"
+#include "PortalSystem.h"
+#include "CompactSearchState.h"
+#include "SearchStats.h"
 #include <vector>
 #include <queue>
 #include <limits>
 
 class AStarSolver {
 public:
-    AStarSolver(Grid &grid, Coord start, Coord goal);
+    // portals (opcional): los portales se expanden como aristas de costo 1
+    AStarSolver(const Grid &grid, Coord start, Coord goal, const PortalSystem *portals = nullptr);
 
     bool step();
 
@@ -16,21 +20,23 @@ public:
     bool getCurrent(Coord &out) const;
     const std::vector<Coord> &getSolution() const;
 
+    // Vistas para visualización (se decodifican del estado compacto)
     enum CellState { UNKNOWN = 0, OPEN = 1, CLOSED = 2 };
-    const std::vector<std::vector<CellState>> &getStateGrid() const { return stateGrid; }
+    std::vector<std::vector<CellState>> getStateGrid() const { return state.decodeStateGrid<CellState>(); }
 
-    const std::vector<std::vector<float>> &getGScoreGrid() const { return gScore; }
+    std::vector<std::vector<float>> getGScoreGrid() const { return state.decodeDistanceGrid(); }
+
+    // Contadores de esta resolución
+    SearchStats getSearchStats() const;
 
 private:
-    Grid &g;
+    const Grid &g;
     Coord start;
     Coord goal;
+    const PortalSystem *portals;
 
-    std::vector<std::vector<CellState>> stateGrid;
-    std::vector<std::vector<bool>> closed;
-    std::vector<std::vector<float>> gScore;
-    std::vector<std::vector<float>> fScore;
-    std::vector<std::vector<Coord>> cameFrom;
+    // Estado/closed/gScore/cameFrom compactos (bits + distancias enteras)
+    CompactSearchState state;
 
     struct PQNode { float f; int id; int x; int y; };
     struct Compare {
@@ -42,12 +48,17 @@ private:
     std::priority_queue<PQNode, std::vector<PQNode>, Compare> openPQ;
     int pushCounter = 0;
 
+    SearchStats stats;
+    PhaseSpan searchSpan;  // Búsqueda: se abre en el primer step() y se cierra al terminar
+
     bool done = false;
     bool solved = false;
     std::vector<Coord> solution;
     Coord current; // last node popped (for visualization)
 
     float heuristic(int x, int y) const;
+    // dir = dirección del movimiento c->n, -1 si es un salto de portal
+    void relax(int cx, int cy, int nx, int ny, int dir);
     void reconstruct_path(int x, int y);
 };
 
@@ -0,0 +1,115 @@
+#pragma once
+#include "Grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ExplorationHeatmap;
+class FlowField;
+
+/**
+ * Simulación de miles de agentes exploradores sobre un mismo laberinto.
+ *
+ * En vez de un objeto solver por agente (cada uno con sus grids completos),
+ * el estado vive en arreglos paralelos (struct-of-arrays): posición, tipo,
+ * semilla, etc. El laberinto es compartido y de solo lectura. Cada agente
+ * tiene en dos arenas contiguas su conjunto de visitados (1 bit por celda)
+ * y la dirección hacia su padre (2 bits por celda) para poder retroceder.
+ *
+ * Los agentes no interactúan entre sí, así que run() reparte rangos de
+ * agentes entre hilos; cada hilo cuenta visitas en su propio buffer y al
+ * final se vuelcan al ExplorationHeatmap compartido.
+ */
+enum class AgentKind : std::uint8_t {
+    WANDERER,   // DFS aleatorio con retroceso
+    SEEKER,     // Visión limitada: elige el vecino no visitado más cercano a la meta
+    FLOW        // Sigue el FlowField (O(1) por tick)
+};
+
+class AgentSystem {
+public:
+    // threadCount = 0 usa std::thread::hardware_concurrency()
+    AgentSystem(const Grid& grid, Coord goal, int threadCount = 0);
+
+    // Necesario para agentes FLOW (sin campo, quedan detenidos)
+    void setFlowField(const FlowField* field) { flow = field; }
+
+    // Agregar un agente; retorna su índice
+    int addAgent(AgentKind kind, Coord start, std::uint32_t seed);
+    // Agregar 'count' agentes en posiciones aleatorias
+    void spawnRandom(int count, AgentKind kind, std::uint32_t seed);
+    void clear();
+
+    // Avanzar todos los agentes 'ticks' pasos (en paralelo).
+    // Cada movimiento cuenta como visita en el heatmap (si no es nullptr).
+    void run(int ticks, ExplorationHeatmap* heatmap = nullptr);
+    void tick(ExplorationHeatmap* heatmap = nullptr) { run(1, heatmap); }
+
+    int getAgentCount() const { return static_cast<int>(posX.size()); }
+    Coord getPosition(int agent) const { return Coord(posX[agent], posY[agent]); }
+    AgentKind getKind(int agent) const { return static_cast<AgentKind>(kind[agent]); }
+    bool isDone(int agent) const { return done[agent] != 0; }
+    bool reachedGoal(int agent) const { return posX[agent] == goal.x && posY[agent] == goal.y; }
+    int getDoneCount() const;
+
+    int getThreadCount() const { return threadCount; }
+
+    // Rendimiento: ticks de agente (agentes activos x ticks) del último run()
+    long long getLastAgentTicks() const { return lastAgentTicks; }
+    double getLastAgentTicksPerSecond() const { return lastAgentTicksPerSecond; }
+    long long getTotalAgentTicks() const { return totalAgentTicks; }
+
+    // Memoria de estado por agente (bytes)
+    size_t bytesPerAgent() const;
+
+private:
+    const Grid& g;
+    Coord goal;
+    int w, h;
+    int threadCount;
+    const FlowField* flow = nullptr;
+
+    size_t visitedWords;   // uint64 por agente en visitedArena
+    size_t parentBytes;    // bytes por agente en parentArena
+
+    // ---- Estado por agente (SoA) ----
+    std::vector<std::int32_t> posX, posY;
+    std::vector<std::int32_t> startX, startY;
+    std::vector<std::uint8_t> kind;
+    std::vector<std::uint8_t> done;
+    std::vector<std::uint32_t> rngState;   // xorshift32
+
+    // ---- Arenas (agente i ocupa un bloque fijo) ----
+    std::vector<std::uint64_t> visitedArena;
+    std::vector<std::uint8_t> parentArena;
+
+    // Buffers de visitas por hilo (se reutilizan entre run())
+    struct Scratch {
+        std::vector<std::uint32_t> visits;
+        std::vector<int> touched;
+        long long agentTicks = 0;
+    };
+    std::vector<Scratch> scratch;
+
+    long long lastAgentTicks = 0;
+    long long totalAgentTicks = 0;
+    double lastAgentTicksPerSecond = 0.0;
+
+    void runRange(size_t begin, size_t end, int ticks, Scratch& s);
+    // Un paso de un agente; retorna la celda a la que se movió o -1
+    int stepAgent(size_t agent);
+    int stepExplorer(size_t agent, bool seeker);
+    int stepFlow(size_t agent);
+
+    bool visited(size_t agent, int cell) const {
+        return (visitedArena[agent * visitedWords + (cell >> 6)] >> (cell & 63)) & 1u;
+    }
+    void markVisited(size_t agent, int cell) {
+        visitedArena[agent * visitedWords + (cell >> 6)] |= std::uint64_t(1) << (cell & 63);
+    }
+    int parentDir(size_t agent, int cell) const {
+        return (parentArena[agent * parentBytes + (cell >> 2)] >> ((cell & 3) * 2)) & 3;
+    }
+    void setParentDir(size_t agent, int cell, int dir);
+    std::uint32_t nextRandom(size_t agent);
+};
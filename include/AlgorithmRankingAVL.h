@@ -1,5 +1,9 @@
 #pragma once
+#include "RunningStats.h"
+#include "SearchStats.h"
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -11,14 +15,37 @@ struct AlgorithmStats {
     int pathLength = 0;          // Longitud del camino final (no usado en score)
     float executionTime = 0.0f;  // Tiempo en segundos
     int treasuresCollected = 0;  // Tesoros recolectados
+    SearchStats search;          // Contadores detallados del solver (no usados en score)
 
-    // Puntuacion compuesta basada en: nodos expandidos, tiempo y tesoros (mayor = mejor)
+    // Distribución por corrida (runs = 0 en una corrida suelta)
+    RunDistribution timeDist;    // executionTime (segundos)
+    RunDistribution nodesDist;   // nodesExpanded
+
+    // Puntuacion compuesta basada en: nodos expandidos, tiempo y tesoros (mayor = mejor).
+    // Con distribución usa las medianas, que no se mueven por una corrida atípica.
     float calculateScore() const;
 
     // Clave única: algorithmName
     std::string getKey() const;
 };
 
+// Agregación en línea de corridas individuales (Welford + cuantiles P²)
+class AlgorithmStatsAccumulator {
+public:
+    void add(const AlgorithmStats& run);
+    int count() const { return static_cast<int>(time.getMoments().count()); }
+
+    // Medias redondeadas en los campos escalares + distribuciones de tiempo y nodos
+    AlgorithmStats summarize(const std::string& name) const;
+
+private:
+    MetricSummary time;
+    MetricSummary nodes;
+    Welford path;
+    Welford treasures;
+    SearchStats search;
+};
+
 // Entrada del ranking (para retornar)
 struct RankEntry {
     AlgorithmStats stats;
@@ -36,9 +63,12 @@ public:
     // OPERACIONES PRINCIPALES
     // ===================================
     
-    // Insertar/actualizar algoritmo
+    // Insertar/actualizar algoritmo (si la clave existe, equivale a update)
     void insert(const AlgorithmStats& stats);
+    // Reemplazar la entrada 'key': O(log n) borrado + reinserción
     void update(const std::string& key, const AlgorithmStats& newStats);
+    // Quitar una entrada; false si no existe
+    bool remove(const std::string& key);
     
     // Obtener top K algoritmos (ordenados por score descendente)
     std::vector<RankEntry> getTopK(int k) const;
@@ -46,15 +76,27 @@ public:
     // Obtener todos los algoritmos ordenados
     std::vector<RankEntry> getAll() const;
     
-    // Buscar un algoritmo específico
+    // Entradas con ranking [firstRank, firstRank + count): O(log n + count)
+    std::vector<RankEntry> getRange(int firstRank, int count) const;
+    
+    // Buscar un algoritmo específico (O(1) vía índice hash)
     bool find(const std::string& key, AlgorithmStats& out) const;
     
+    // Ranking (1 = mejor) de 'key'; 0 si no existe. O(log n)
+    int rankOf(const std::string& key) const;
+    
+    // Entrada con ranking 'rank' (1 = mejor); false si está fuera de rango. O(log n)
+    bool select(int rank, AlgorithmStats& out) const;
+    
     // Número de algoritmos en el árbol
     int size() const;
     
-    // Limpiar árbol
+    // Limpiar árbol: O(1), la arena y la tabla de nombres se reutilizan
     void clear();
     
+    // Memoria reservada por la arena, el payload y la tabla de nombres
+    size_t bytesUsed() const;
+    
     // Verificar si el árbol está balanceado (debug)
     bool isBalanced() const;
     
@@ -63,69 +105,93 @@ public:
 
 private:
     // ===================================
-    // NODO DEL ÁRBOL AVL
+    // NODO DEL ÁRBOL AVL (arena)
     // ===================================
+    // Los nodos viven en un vector contiguo y se enlazan con índices de 32 bits.
+    // Solo los campos calientes de comparación/balanceo están en el nodo; las
+    // métricas completas van en 'payload' (mismo índice) y el nombre está
+    // internado en 'names'.
+    // Orden: score descendente; empates por nombre ascendente (orden determinista)
+    using NodeId = std::uint32_t;
+    static constexpr NodeId NIL = 0xffffffffu;
+    
     struct AVLNode {
-        AlgorithmStats data;
-        float score;  // Cache del score para comparaciones
-        
-        AVLNode* left;
-        AVLNode* right;
+        float score;         // Cache del score para comparaciones
+        std::uint32_t name;  // Id del nombre internado (desempate + índice)
+        NodeId left;
+        NodeId right;
         int height;
-        
-        AVLNode(const AlgorithmStats& stats) 
-            : data(stats), 
-              score(stats.calculateScore()),
-              left(nullptr), 
-              right(nullptr), 
-              height(1) {}
+        int count;           // Nodos en este subárbol (estadística de orden)
     };
     
-    AVLNode* root;
+    std::vector<AVLNode> nodes;           // Arena: [0, used) está en uso o en freeSlots
+    std::vector<AlgorithmStats> payload;  // Métricas completas, paralelo a 'nodes'
+    std::vector<NodeId> freeSlots;        // Nodos liberados por remove()
+    NodeId used;
+    NodeId root;
     int nodeCount;
     
+    // Tabla de nombres internados (sobrevive a clear(): los ids son estables).
+    // nodeOfName[id] solo es válido si nameEpoch[id] == epoch, así clear() no
+    // tiene que recorrer el índice.
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> nameIds;
+    std::vector<NodeId> nodeOfName;
+    std::vector<std::uint32_t> nameEpoch;
+    std::uint32_t epoch;
+    
     // ===================================
     // FUNCIONES AUXILIARES
     // ===================================
     
+    // Id internado de un nombre (lo crea si no existe)
+    std::uint32_t internName(const std::string& name);
+    // Nodo del nombre en el árbol actual; NIL si no está
+    NodeId lookup(const std::string& key) const;
+    // Tomar un nodo de la arena (reutiliza huecos de remove())
+    NodeId allocNode(const AlgorithmStats& stats, std::uint32_t name);
+    
     // Altura de un nodo
-    int height(AVLNode* node) const;
+    int height(NodeId node) const;
+    
+    // Tamaño de un subárbol
+    int subtreeSize(NodeId node) const;
     
     // Factor de balance
-    int getBalance(AVLNode* node) const;
+    int getBalance(NodeId node) const;
     
-    // Actualizar altura
-    void updateHeight(AVLNode* node);
+    // Actualizar altura y tamaño del subárbol
+    void updateHeight(NodeId node);
     
     // ===================================
     // ROTACIONES (AUTO-BALANCEO)
     // ===================================
     
     // Rotación simple derecha (LL)
-    AVLNode* rotateRight(AVLNode* y);
+    NodeId rotateRight(NodeId y);
     
     // Rotación simple izquierda (RR)
-    AVLNode* rotateLeft(AVLNode* x);
+    NodeId rotateLeft(NodeId x);
     
     // Rotación doble izquierda-derecha (LR)
-    AVLNode* rotateLeftRight(AVLNode* node);
+    NodeId rotateLeftRight(NodeId node);
     
     // Rotación doble derecha-izquierda (RL)
-    AVLNode* rotateRightLeft(AVLNode* node);
+    NodeId rotateRightLeft(NodeId node);
     
     // ===================================
     // OPERACIONES RECURSIVAS
     // ===================================
     
-    AVLNode* insertNode(AVLNode* node, const AlgorithmStats& stats);
-    AVLNode* deleteNode(AVLNode* node, const std::string& key);
-    AVLNode* findMin(AVLNode* node) const;
-    AVLNode* balance(AVLNode* node);
+    // ¿El nodo a va antes que el nodo b en el ranking?
+    bool ranksBefore(NodeId a, NodeId b) const;
     
-    void inorderTraversal(AVLNode* node, std::vector<AVLNode*>& result) const;
-    void destroyTree(AVLNode* node);
+    NodeId insertNode(NodeId node, NodeId fresh);
+    // Desengancha 'target' (buscado por score+nombre) sin liberarlo
+    NodeId detachNode(NodeId node, NodeId target);
+    // Desengancha el mínimo del subárbol y lo devuelve en 'minOut'
+    NodeId detachMin(NodeId node, NodeId& minOut);
+    NodeId balance(NodeId node);
     
-    AVLNode* findNode(AVLNode* node, const std::string& key) const;
-    
-    bool isBalancedHelper(AVLNode* node) const;
-};
\ No newline at end of file
+    bool isBalancedHelper(NodeId node) const;
+};
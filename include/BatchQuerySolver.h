@@ -0,0 +1,59 @@
+#pragma once
+#include "Grid.h"
+#include "SearchStats.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Consultas por lote sobre un mismo laberinto.
+ * Las consultas se agrupan por origen: cada grupo se responde con UNA sola
+ * búsqueda desde ese origen (BFS, costo uniforme) que se detiene cuando
+ * alcanzó todas las metas del grupo. Los grupos se reparten entre hilos y
+ * cada hilo reutiliza sus buffers entre grupos y entre llamadas a solve().
+ */
+struct PathQuery {
+    Coord start;
+    Coord goal;
+};
+
+struct QueryResult {
+    int distance = -1;          // -1 = inalcanzable
+    std::vector<Coord> path;    // Vacío si no se pidieron caminos
+};
+
+class BatchQuerySolver {
+public:
+    // threadCount = 0 usa std::thread::hardware_concurrency()
+    explicit BatchQuerySolver(const Grid& grid, int threadCount = 0);
+
+    // Responder todas las consultas (mismo orden que la entrada)
+    std::vector<QueryResult> solve(const std::vector<PathQuery>& queries, bool wantPaths = true);
+
+    int getThreadCount() const { return threadCount; }
+
+    // Contadores del último solve() (tiempos = suma de todos los hilos)
+    const SearchStats& getSearchStats() const { return lastStats; }
+
+private:
+    // Buffers de trabajo por hilo. Se invalidan con un "epoch" en vez de
+    // reinicializarlos, así cada búsqueda solo toca las celdas que visita.
+    struct Scratch {
+        std::vector<std::uint32_t> seen;    // seen[id] == epoch -> visitado
+        std::vector<std::uint32_t> target;  // target[id] == epoch -> meta del grupo
+        std::vector<int> dist;
+        std::vector<int> parent;
+        std::vector<int> queue;
+        std::uint32_t epoch = 0;
+        SearchStats stats;
+    };
+
+    const Grid& g;
+    int threadCount;
+    std::vector<Scratch> scratch;
+    SearchStats lastStats;
+
+    void prepareScratch(Scratch& s);
+    void solveGroup(Scratch& s, int sourceId, const std::vector<int>& queryIdx,
+                    const std::vector<PathQuery>& queries,
+                    std::vector<QueryResult>& results, bool wantPaths);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "AlgorithmRankingAVL.h"
+#include "ChallengeSystem.h"
+#include "Grid.h"
+#include "HeatmapAggregator.h"
+#include "MazeAlgorithm.h"
+#include "SolverStrategy.h"
+#include <ctime>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Benchmark de solvers sin dependencias de ventana: lo usan el ranking de
+ * main.cpp y el ejecutable headless maze_bench.
+ */
+
+// Generadores del modo coleccionista, en el orden del ranking
+const std::vector<std::string>& benchmarkGenerators();
+
+// Solvers comparados en el ranking (estrategia, nombre)
+const std::vector<std::pair<SolverStrategy, std::string>>& benchmarkSolvers();
+
+// Crear el generador (modo coleccionista) por nombre; nombres desconocidos usan DFS.
+// El mismo seed da el mismo laberinto (los generadores usan std::rand: no son
+// seguros entre hilos, generar en un solo hilo)
+std::unique_ptr<MazeAlgorithm> makeCollectorGenerator(const std::string& genAlgo, Grid& grid,
+                                                      ChallengeSystem* challenges,
+                                                      unsigned seed = static_cast<unsigned>(std::time(nullptr)));
+
+// Laberinto generado una vez y compartido (solo lectura) entre varios solvers
+struct PreparedMaze {
+    std::string generator;
+    unsigned seed = 0;
+    std::unique_ptr<Grid> grid;
+    std::unique_ptr<ChallengeSystem> challenges;  // Tesoros iniciales: cada solver resuelve sobre una copia
+    Coord start;
+    Coord goal;
+};
+
+// Generar el laberinto (con tesoros), el inicio y la meta a partir de un seed
+PreparedMaze prepareBenchmarkMaze(const std::string& genAlgo, int gridW, int gridH, unsigned seed);
+
+// Resolver un laberinto preparado; el tiempo medido es solo el de la resolución.
+// No modifica 'maze': se puede llamar desde varios hilos sobre el mismo laberinto
+AlgorithmStats solvePreparedMaze(const PreparedMaze& maze, SolverStrategy strategy,
+                                 const std::string& solverName,
+                                 HeatmapAggregator::Shard* heatShard = nullptr);
+
+// Ejecutar UN benchmark: un solver en un laberinto generado
+// heatShard (opcional): acumula el heatmap de exploración de la corrida
+AlgorithmStats runSingleBenchmark(const std::string& genAlgo, SolverStrategy strategy,
+                                  const std::string& solverName, int gridW, int gridH,
+                                  HeatmapAggregator::Shard* heatShard = nullptr);
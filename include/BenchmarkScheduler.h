@@ -0,0 +1,65 @@
+#pragma once
+#include "BenchmarkRunner.h"
+#include "HeatmapAggregator.h"
+#include "WorkStealingPool.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Matriz de benchmark (generador x iteración x solver) en paralelo.
+ *
+ * 1. Genera todos los laberintos en el hilo que llama (los generadores usan
+ *    std::rand, que es estado global). El seed de cada laberinto sale de
+ *    baseSeed, el generador y la iteración: misma config, mismos laberintos.
+ * 2. Resuelve cada (laberinto, solver) como una tarea del WorkStealingPool.
+ *    Los laberintos se comparten de solo lectura y cada tarea escribe en su
+ *    propio casillero de resultados, así que el orden de los resultados no
+ *    depende de la cantidad de hilos.
+ *
+ * Solo se mide el tiempo de resolución de cada tarea (como runSingleBenchmark);
+ * con varios hilos ese tiempo incluye la competencia por caché y memoria.
+ */
+struct BenchmarkConfig {
+    std::vector<std::string> generators;
+    std::vector<std::pair<SolverStrategy, std::string>> solvers;
+    int iterations = 30;
+    int width = 40;
+    int height = 28;
+    unsigned baseSeed = 0;
+    int threadCount = 0;  // 0 = hardware_concurrency
+};
+
+struct BenchmarkResult {
+    int generator = 0;  // Índices en BenchmarkConfig
+    int solver = 0;
+    int iteration = 0;
+    AlgorithmStats stats;
+};
+
+class BenchmarkScheduler {
+public:
+    explicit BenchmarkScheduler(BenchmarkConfig config);
+
+    int getThreadCount() const { return pool.getThreadCount(); }
+
+    // Ejecutar la matriz completa. Resultados ordenados por generador,
+    // iteración y solver. heatmaps (opcional): uno por solver, con al menos
+    // getThreadCount() shards (cada worker escribe solo en el suyo)
+    std::vector<BenchmarkResult> run(std::vector<HeatmapAggregator>* heatmaps = nullptr);
+
+    // Seed del laberinto (generador, iteración)
+    unsigned mazeSeed(int generator, int iteration) const;
+
+    // Estadísticas del último run()
+    double getLastGenerateSeconds() const { return lastGenerateSeconds; }
+    double getLastSolveSeconds() const { return lastSolveSeconds; }  // Reloj de pared
+    size_t getLastSteals() const { return pool.getLastSteals(); }
+
+private:
+    BenchmarkConfig config;
+    WorkStealingPool pool;
+    double lastGenerateSeconds = 0.0;
+    double lastSolveSeconds = 0.0;
+};
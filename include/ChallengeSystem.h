@@ -1,7 +1,10 @@
 #pragma once
 #include "Grid.h"
-#include "CoordHash.h" 
-#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <vector>
 
 
@@ -10,20 +13,60 @@ enum class SpecialElement {
     NONE
 };
 
+/**
+ * Tesoros del modo Collector, indexados para mapas con 10^5+ tesoros.
+ *
+ *  - Bitmap denso de tesoros restantes: hasTreasure() en O(1) sin hash.
+ *  - Índice espacial por cubetas de BUCKET_SIZE x BUCKET_SIZE celdas: cada
+ *    cubeta lista sus tesoros restantes; recolectar hace swap-and-pop en O(1)
+ *    (cada celda recuerda su posición dentro de la cubeta).
+ *  - nearestTreasure() recorre anillos de cubetas alrededor del origen y
+ *    corta en cuanto ningún anillo más lejano puede mejorar la distancia.
+ *
+ * Distancias en Manhattan (igual que las heurísticas de los solvers).
+ *
+ * Modo concurrente (setConcurrentMode(true)): varios solvers/agentes pueden
+ * llamar collectTreasure() en paralelo sobre el mismo mapa. El bit del
+ * tesoro se reclama con un fetch_and atómico (solo un recolector ve el bit
+ * encendido) y el contador es atómico. Las cubetas no se tocan mientras
+ * dura el modo: las consultas saltan tesoros ya reclamados y al salir del
+ * modo se compactan. Colocar tesoros y clear() siguen siendo de un solo hilo.
+ */
 class ChallengeSystem {
 public:
+    static constexpr int BUCKET_SIZE = 16;
+
     ChallengeSystem(Grid& grid);
+    // Copia independiente del estado actual (p.ej. una por tarea de benchmark)
+    ChallengeSystem(const ChallengeSystem& other);
+    ChallengeSystem& operator=(const ChallengeSystem&) = delete;
     
     // Colocar tesoro en posición específica
     void placeTreasureAt(const Coord& pos);
     
     // Verificar si una coordenada tiene tesoro
-    bool hasTreasure(const Coord& pos) const;
+    bool hasTreasure(const Coord& pos) const {
+        if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height) return false;
+        size_t id = cellId(pos);
+        return (treasureBits[id >> 6].load(std::memory_order_acquire) >> (id & 63)) & 1u;
+    }
     
-    // Recolectar tesoro (cambia estado a NONE)
+    // Recolectar tesoro (cambia estado a NONE). true solo para el recolector
+    // que lo reclamó; seguro entre hilos en modo concurrente.
     bool collectTreasure(const Coord& pos);
+
+    // Activar/desactivar el modo concurrente (llamar sin otros hilos activos)
+    void setConcurrentMode(bool enabled);
+    bool isConcurrentMode() const { return concurrentMode; }
+
+    // Tesoros recolectados (por cualquier recolector)
+    int getCollectedCount() const { return collectedCount.load(std::memory_order_acquire); }
+
+    // Tesoros restantes leídos sin locks (cada palabra del bitmap se lee de
+    // forma atómica; con recolectores activos es una foto aproximada)
+    std::vector<Coord> snapshotRemaining() const;
     
-    // Obtener todas las posiciones de tesoros
+    // Obtener todas las posiciones de tesoros (incluye los ya recolectados)
     const std::vector<Coord>& getTreasurePositions() const;
     
     // Verificar si todos fueron recolectados
@@ -31,17 +74,40 @@ public:
     
     // Número de tesoros restantes
     int remainingTreasures() const;
+
+    // Tesoro restante más cercano (Manhattan); vacío si no queda ninguno
+    std::optional<Coord> nearestTreasure(const Coord& from) const;
+    // Igual, considerando solo los tesoros que 'accept' acepta (p.ej. alcanzables)
+    std::optional<Coord> nearestTreasure(const Coord& from, const std::function<bool(const Coord&)>& accept) const;
+
+    // Tesoros restantes a distancia Manhattan <= radius
+    std::vector<Coord> treasuresWithinRadius(const Coord& center, int radius) const;
     
     // Limpiar todos los tesoros
     void clear();
 
-    // Público para que CollectorSolver pueda acceder
-    int collectedCount = 0;
-
 private:
     Grid& g;
+    int width, height;
+    int bucketsX, bucketsY;
+    
+    std::atomic<int> collectedCount{0};
+    bool concurrentMode = false;
     
-    std::unordered_map<Coord, SpecialElement, CoordHash> elements;
+    std::vector<std::atomic<std::uint64_t>> treasureBits;  // Tesoros restantes (1 bit por celda)
+    std::vector<std::uint64_t> placedBits;       // Alguna vez colocado (evita duplicados)
+    std::vector<std::vector<std::uint32_t>> buckets;  // ids de celda restantes por cubeta
+    std::vector<std::int32_t> slotInBucket;      // Posición de cada celda en su cubeta (-1 = ninguna)
     
     std::vector<Coord> treasurePositions;
-};
\ No newline at end of file
+
+    size_t cellId(const Coord& c) const { return static_cast<size_t>(c.y) * width + c.x; }
+    int bucketOf(int x, int y) const { return (y / BUCKET_SIZE) * bucketsX + (x / BUCKET_SIZE); }
+    // Distancia Manhattan mínima de 'p' a cualquier celda de la cubeta (bx, by)
+    int distanceToBucket(const Coord& p, int bx, int by) const;
+    bool isRemaining(std::uint32_t id) const {
+        return (treasureBits[id >> 6].load(std::memory_order_acquire) >> (id & 63)) & 1u;
+    }
+    // Quitar de las cubetas los tesoros reclamados en modo concurrente
+    void compactBuckets();
+};
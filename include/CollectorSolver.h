@@ -2,16 +2,16 @@
 #include "Grid.h"
 #include "ChallengeSystem.h"
 #include "ExplorationHeatmap.h"
+#include "SolverStrategy.h"
+#include "CompactSearchState.h"
+#include "DeadEndFillSolver.h"
+#include "SearchStats.h"
+#include "PathCache.h"
+#include "Generator.h"
 #include <vector>
 #include <queue>
 #include <limits>
-
-enum class SolverStrategy {
-    ASTAR,      
-    GREEDY,     
-    UCS,        
-    DFS        
-};
+#include <memory>
 
 
 struct PathSegment {
@@ -26,11 +26,15 @@ struct PathSegment {
 
 class CollectorSolver {
 public:
-    CollectorSolver(Grid& grid, ChallengeSystem& challenges, 
+    CollectorSolver(const Grid& grid, ChallengeSystem& challenges, 
                     Coord start, Coord finalGoal,
                     SolverStrategy strategy = SolverStrategy::ASTAR);
+
+    // La corrutina guarda 'this': el solver no se copia ni se mueve
+    CollectorSolver(const CollectorSolver&) = delete;
+    CollectorSolver& operator=(const CollectorSolver&) = delete;
     
-    // Ejecutar un paso del algoritmo
+    // Ejecutar un paso del algoritmo (una expansión)
     bool step();
     
     // ¿Ya terminó?
@@ -45,7 +49,7 @@ public:
     // Obtener segmentos con colores
     const std::vector<PathSegment>& getSegments() const;
     
-    // Número de tesoros recolectados
+    // Número de tesoros recolectados por ESTE solver
     int getTreasuresCollected() const;
     
     // Índice del objetivo actual
@@ -55,17 +59,26 @@ public:
     SolverStrategy getStrategy() const { return strategy; }
 
     const ExplorationHeatmap& getHeatmap() const { return heatmap; }
+    // Acceso para que una vista en vivo active seguimiento de cambios o pirámide
+    ExplorationHeatmap& getHeatmap() { return heatmap; }
 
     // Obtener número de nodos expandidos (celdas marcadas como CLOSED)
     int getNodesExpanded() const { return nodesExpandedCount; }
 
+    // Contadores acumulados de todos los segmentos
+    SearchStats getSearchStats() const;
+
+    // Caché opcional de tramos (no se adueña del puntero). Un tramo encontrado
+    // en la caché se recorre directamente: solo recolecta tesoros sobre el camino.
+    void setPathCache(PathCache* cache) { pathCache = cache; }
+
     // Estados para visualización
     enum CellState { UNKNOWN = 0, OPEN = 1, CLOSED = 2, TREASURE_COLLECTED = 3 };
-    const std::vector<std::vector<CellState>>& getStateGrid() const { return stateGrid; }
-    const std::vector<std::vector<float>>& getGScoreGrid() const { return gScore; }
+    std::vector<std::vector<CellState>> getStateGrid() const { return state.decodeStateGrid<CellState>(); }
+    std::vector<std::vector<float>> getGScoreGrid() const { return state.decodeDistanceGrid(); }
 
 private:
-    Grid& g;
+    const Grid& g;
     ChallengeSystem& challenges;
     Coord start;
     Coord finalGoal;
@@ -73,17 +86,22 @@ private:
     
     ExplorationHeatmap heatmap;
     
-    // Lista ordenada de objetivos
+    // Con muchos tesoros, el orden global (O(T^2)) se reemplaza por
+    // "tesoro restante más cercano" consultado al índice espacial
+    static constexpr int NEAREST_OBJECTIVE_THRESHOLD = 64;
+    bool nearestObjectiveMode = false;
+
+    // Lista ordenada de objetivos (en modo "más cercano" crece de a uno)
     std::vector<Coord> objectives;
+    // Celdas alcanzables desde el recolector (1 = sí). Se arma recién cuando
+    // un tramo falla; desde ahí el modo "más cercano" ignora lo inalcanzable
+    std::vector<char> reachable;
     int currentObjectiveIndex = 0;
     Coord currentGoal;
     
-    // Estructuras A*/Greedy/UCS compartidas
-    std::vector<std::vector<CellState>> stateGrid;
-    std::vector<std::vector<bool>> closed;
-    std::vector<std::vector<float>> gScore;
-    std::vector<std::vector<float>> fScore;
-    std::vector<std::vector<Coord>> cameFrom;
+    // Estado compartido por A*/Greedy/UCS/DFS (bits + distancias enteras).
+    // TREASURE_COLLECTED se guarda como CompactSearchState::MARKED.
+    CompactSearchState state;
     
     struct PQNode { float f; int id; int x; int y; };
     struct Compare {
@@ -96,7 +114,12 @@ private:
     int pushCounter = 0;
  
     std::vector<Coord> dfsStack;
-    std::vector<std::vector<bool>> dfsVisited;
+
+    // Relleno de callejones del segmento actual (solo DEADEND_FILL)
+    std::unique_ptr<DeadEndFillSolver> deadEndFill;
+
+    PathCache* pathCache = nullptr;
+    Coord segmentStart;
     
     Coord currentPos;
     std::vector<Coord> currentSegmentPath;
@@ -104,29 +127,39 @@ private:
     
     std::vector<PathSegment> segments;
     PathSegment currentSegment;
-    
-    bool segmentDone = false;
-    bool allDone = false;
 
     // Contador de nodos expandidos (celdas marcadas como CLOSED)
     int nodesExpandedCount = 0;
+    // Tesoros que este solver reclamó (el mapa puede ser compartido)
+    int treasuresCollected = 0;
+    SearchStats stats;
+    PhaseSpan searchSpan;  // Búsqueda de un tramo: abarca los step() de sus expansiones
+
+    // Todos los tramos como corrutina: un co_yield por expansión (o por pasada
+    // del relleno); step()/finished() solo la reanudan y consultan.
+    // Va al final: se destruye antes que el estado que usa
+    Generator<Coord> events;
+    Generator<Coord> run();
 
     // Funciones auxiliares
-    void initializeSearch(Coord from, Coord to);
-    void initializeDFS(Coord from, Coord to);
+    void beginSegment(Coord to);
+    void closeSegment(bool fromCache);
     
-    bool stepAStar();
-    bool stepGreedy();
-    bool stepUCS();
-    bool stepDFS();
+    bool popFrontier(Coord& out);
+    void expandCell(const Coord& cell);
+    void pushNeighbors(const Coord& cell);
+    void collectGoal();
     
     void reconstructSegment();
+    void walkSegmentPath(bool fromCache);
     
     float heuristic(int x, int y, const Coord& goal) const;
     float manhattan(const Coord& a, const Coord& b) const;
     
     void checkOpportunisticCollection();
     void removeFromObjectives(const Coord& pos);
+    Coord nextNearestObjective(const Coord& from) const;
+    void markReachable(Coord from);
     
     std::vector<Coord> greedyOrderTreasures(Coord from, const std::vector<Coord>& treasures, Coord goal);
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+#include "Grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class PortalSystem;
+
+/**
+ * Estado de búsqueda compacto para los solvers.
+ *
+ * En vez de varios vector<vector<...>> separados (gScore float, cameFrom Coord,
+ * CellState enum, closed bool ~25 bytes/celda), se guarda:
+ *  - estado OPEN/CLOSED como dos planos de bits (1 bit c/u por celda)
+ *  - padre como dirección de 2 bits (0=Up, 1=Left, 2=Right, 3=Down)
+ *    + 1 bit "vino por portal" (el padre es la salida del portal)
+ *  - distancia entera en el ancho más angosto que cabe (1, 2 o 4 bytes)
+ *
+ * Distancia y padre solo son válidos para celdas alcanzadas (estado != UNKNOWN),
+ * así que reset() solo limpia los planos de bits: O(celdas / 64).
+ * Las vistas para visualización se decodifican bajo demanda.
+ */
+class CompactSearchState {
+public:
+    // Mismo orden que los CellState de los solvers (0=UNKNOWN, 1=OPEN, 2=CLOSED)
+    // MARKED = OPEN|CLOSED (CollectorSolver lo usa para TREASURE_COLLECTED)
+    enum State { UNKNOWN = 0, OPEN = 1, CLOSED = 2, MARKED = 3 };
+
+    static constexpr std::uint32_t UNREACHED = std::numeric_limits<std::uint32_t>::max();
+
+    CompactSearchState(int width, int height);
+
+    // Olvidar la búsqueda anterior (solo limpia los planos de bits)
+    void reset();
+
+    int width() const { return w; }
+    int height() const { return h; }
+
+    // ---- Estado ----
+    State getState(int x, int y) const {
+        size_t id = index(x, y);
+        return static_cast<State>(bit(openBits, id) | (bit(closedBits, id) << 1));
+    }
+    bool isReached(int x, int y) const { return getState(x, y) != UNKNOWN; }
+    bool isClosed(int x, int y) const { return bit(closedBits, index(x, y)) != 0; }
+    void setState(int x, int y, State s);
+
+    // ---- Distancia (g) ----
+    std::uint32_t getDistance(int x, int y) const {
+        if (!isReached(x, y)) return UNREACHED;
+        size_t id = index(x, y);
+        switch (distBytes) {
+            case 1: return dist8[id];
+            case 2: return dist16[id];
+            default: return dist32[id];
+        }
+    }
+    void setDistance(int x, int y, std::uint32_t d) {
+        size_t id = index(x, y);
+        switch (distBytes) {
+            case 1: dist8[id] = static_cast<std::uint8_t>(d); break;
+            case 2: dist16[id] = static_cast<std::uint16_t>(d); break;
+            default: dist32[id] = d; break;
+        }
+    }
+
+    // ---- Padre ----
+    // dir = dirección desde la celda hacia su padre; -1 = sin padre (origen)
+    void setParentDir(int x, int y, int dir);
+    // Padre vía portal (la dirección no aplica: el padre es la salida del portal)
+    void setParentPortal(int x, int y);
+    void clearParent(int x, int y);
+    int getParentDir(int x, int y) const;
+    bool parentIsPortal(int x, int y) const { return bit(portalBits, index(x, y)) != 0; }
+
+    // Camino origen -> to siguiendo los padres (portals: para resolver saltos)
+    std::vector<Coord> tracePath(Coord to, const PortalSystem* portals = nullptr) const;
+
+    // Dirección opuesta (0=Up<->3=Down, 1=Left<->2=Right)
+    static int oppositeDir(int dir) { return 3 - dir; }
+
+    // ---- Vistas decodificadas (visualización) ----
+    template <typename StateEnum>
+    std::vector<std::vector<StateEnum>> decodeStateGrid() const {
+        std::vector<std::vector<StateEnum>> grid(w, std::vector<StateEnum>(h, static_cast<StateEnum>(UNKNOWN)));
+        for (int x = 0; x < w; ++x)
+            for (int y = 0; y < h; ++y)
+                grid[x][y] = static_cast<StateEnum>(getState(x, y));
+        return grid;
+    }
+    // Celdas no alcanzadas = infinito (igual que los gScore anteriores)
+    std::vector<std::vector<float>> decodeDistanceGrid() const;
+    // Celdas alcanzadas (OPEN, CLOSED o MARKED)
+    std::vector<std::vector<bool>> decodeReachedGrid() const;
+
+    // Ancho de la distancia en bytes (1, 2 o 4)
+    int getDistanceBytes() const { return distBytes; }
+
+    // Memoria usada por el estado (bytes)
+    size_t bytesUsed() const;
+
+private:
+    int w, h;
+    int distBytes;
+
+    std::vector<std::uint64_t> openBits;
+    std::vector<std::uint64_t> closedBits;
+    std::vector<std::uint64_t> hasParentBits;
+    std::vector<std::uint64_t> portalBits;
+    std::vector<std::uint8_t> parentDirs;   // 4 celdas por byte
+
+    // Solo uno de los tres se usa, según distBytes
+    std::vector<std::uint8_t> dist8;
+    std::vector<std::uint16_t> dist16;
+    std::vector<std::uint32_t> dist32;
+
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * w + x; }
+
+    static std::uint64_t bit(const std::vector<std::uint64_t>& plane, size_t id) {
+        return (plane[id >> 6] >> (id & 63)) & 1u;
+    }
+    static void setBit(std::vector<std::uint64_t>& plane, size_t id, bool value) {
+        std::uint64_t mask = std::uint64_t(1) << (id & 63);
+        if (value) plane[id >> 6] |= mask;
+        else plane[id >> 6] &= ~mask;
+    }
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include "MazeAlgorithm.h"
+#include "Generator.h"
+
+/**
+ * Adaptador: un generador escrito como corrutina (co_yield de la celda
+ * actual tras cada evento visible) expuesto como MazeAlgorithm.
+ * El constructor corre la inicialización hasta el primer co_yield, así el
+ * estado del grid es el mismo que con los constructores anteriores.
+ * step() = un evento (modo visual); runToEnd() = bucle apretado (headless).
+ */
+struct CoroutineMazeAlgorithm : public MazeAlgorithm {
+    explicit CoroutineMazeAlgorithm(Generator<Coord> body) : events(std::move(body)) {
+        events.next();
+    }
+
+    bool step() override {
+        events.next();
+        return events.done();
+    }
+
+    bool finished() const override { return events.done(); }
+
+    bool getCurrent(Coord &out) const override {
+        if (events.done()) return false;
+        out = events.value();
+        return true;
+    }
+
+    void runToEnd() override {
+        while (events.next()) {}
+    }
+
+protected:
+    Generator<Coord> events;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "Grid.h"
+#include "SearchStats.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Dead-end filling: solver sin búsqueda para laberintos.
+ * Cada paso (step) es una pasada sobre filas completas de bits: se calcula el
+ * grado de cada celda viva con contadores "bit-sliced" (2 planos: >=1 y >=2
+ * vecinos vivos) y se eliminan todas las celdas de grado <= 1 excepto inicio
+ * y meta. Solo se recalculan filas marcadas como sucias (ellas o sus vecinas
+ * cambiaron en la pasada anterior).
+ * Cuando ya no cambia nada, en un laberinto perfecto solo queda el corredor
+ * de la solución, que se recorre desde el inicio.
+ */
+class DeadEndFillSolver {
+public:
+    DeadEndFillSolver(const Grid &grid, Coord start, Coord goal);
+
+    // Una pasada de relleno (o el recorrido final); true al terminar
+    bool step();
+
+    bool finished() const { return done; }
+    bool getCurrent(Coord &out) const;
+    const std::vector<Coord> &getSolution() const { return solution; }
+
+    // Celdas rellenadas como callejón sin salida, indexado [x][y]
+    std::vector<std::vector<bool>> getDeadEndMap() const;
+    bool isDeadEnd(int x, int y) const { return !bit(alive, x, y); }
+
+    int getPassCount() const { return passes; }
+    int getFilledCount() const { return filledCount; }
+
+    // pops = celdas rellenadas; searchTime = pasadas; reconstructTime = recorrido
+    SearchStats getSearchStats() const;
+
+private:
+    const Grid &g;
+    Coord start;
+    Coord goal;
+
+    int w, h;
+    int wordsPerRow;
+
+    // Planos de bits por fila (wordsPerRow palabras cada una)
+    std::vector<std::uint64_t> alive;      // celda aún no rellenada
+    std::vector<std::uint64_t> openRight;  // sin pared entre x y x+1
+    std::vector<std::uint64_t> openDown;   // sin pared entre y e y+1
+    std::vector<std::uint64_t> keep;       // inicio y meta (nunca se rellenan)
+
+    std::vector<char> rowDirty;            // fila a recalcular en la pasada actual
+    std::vector<std::uint64_t> deadScratch;
+
+    bool filling = true;
+    bool done = false;
+    int passes = 0;
+    int filledCount = 0;
+    SearchStats stats;
+    std::vector<Coord> solution;
+
+    const std::uint64_t *row(const std::vector<std::uint64_t> &plane, int y) const {
+        return plane.data() + static_cast<size_t>(y) * wordsPerRow;
+    }
+    std::uint64_t *row(std::vector<std::uint64_t> &plane, int y) {
+        return plane.data() + static_cast<size_t>(y) * wordsPerRow;
+    }
+    bool bit(const std::vector<std::uint64_t> &plane, int x, int y) const {
+        return (row(plane, y)[x >> 6] >> (x & 63)) & 1u;
+    }
+    void setBit(std::vector<std::uint64_t> &plane, int x, int y) {
+        row(plane, y)[x >> 6] |= std::uint64_t(1) << (x & 63);
+    }
+
+    bool fillPass();
+    void walkCorridor();
+};
@@ -1,33 +1,62 @@
 #pragma once
 #include "Grid.h"
-#include "CoordHash.h" 
-#include <unordered_map>
+#include "MipPyramid.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 #include <algorithm>
 
-
+/**
+ * Contador de visitas por celda con almacenamiento adaptativo.
+ *
+ * Mientras pocas celdas tienen visitas se usa una tabla hash de
+ * direccionamiento abierto (sondeo lineal, clave = id de celda y*ancho+x,
+ * hash multiplicativo de Fibonacci). Cuando las celdas visitadas superan
+ * ~1/4 del grid, la tabla ya ocupa tanto como un arreglo plano y se pasa
+ * a modo denso: un contador por celda, acceso directo sin hash.
+ *
+ * Máximo, total y celdas únicas se mantienen al insertar, así que
+ * getMaxVisits() y getStats() son O(1).
+ */
 class ExplorationHeatmap {
 public:
     ExplorationHeatmap(int width, int height);
     
     // Registrar visita a una celda
-    void recordVisit(int x, int y);
+    void recordVisit(int x, int y) { recordVisits(x, y, 1); }
+    
+    // Registrar varias visitas de una vez (volcado de contadores por lote)
+    void recordVisits(int x, int y, int count);
     
     // Obtener número de visitas
     int getVisitCount(int x, int y) const;
     
     // Obtener máximo de visitas (para normalización)
-    int getMaxVisits() const;
+    int getMaxVisits() const { return maxVisits; }
     
     // Obtener número total de celdas visitadas
-    int getTotalCellsVisited() const;
+    int getTotalCellsVisited() const { return uniqueCells; }
     
-    // Limpiar heatmap
+    // Limpiar heatmap (vuelve a modo disperso)
     void clear();
     
     // Obtener grid normalizado [0.0, 1.0] para visualización
     std::vector<std::vector<float>> toNormalizedGrid() const;
     
+    // Escribir colores RGBA (HeatmapColormap) en un buffer del llamador de
+    // ancho*alto*4 bytes, fila por fila (listo para sf::Texture::update).
+    // Con el seguimiento de cambios activo solo reescribe las celdas visitadas
+    // desde la llamada anterior, salvo que cambie el máximo (cambia la
+    // normalización) o fullRepaint = true; sin seguimiento repinta todo.
+    // Retorna cuántas celdas se escribieron.
+    int writeRGBA(std::uint8_t* pixels, bool fullRepaint = false) const;
+
+    // Seguimiento de celdas cambiadas para writeRGBA incremental (vista en vivo).
+    // Desactivado por defecto: cuesta un bitset de W*H bits y una rama por visita
+    void enableDirtyTracking();
+    bool isDirtyTracking() const { return dirtyTracking; }
+    
     // Obtener estadísticas
     struct HeatmapStats {
         int totalVisits = 0;      // Suma de todas las visitas
@@ -38,10 +67,61 @@ public:
     };
     HeatmapStats getStats() const;
 
+    // Recorrer celdas con visitas: f(x, y, visitas)
+    template <typename F>
+    void forEachVisited(F&& f) const {
+        if (dense) {
+            for (size_t id = 0; id < denseCounts.size(); ++id)
+                if (denseCounts[id] > 0) f(static_cast<int>(id % width), static_cast<int>(id / width), denseCounts[id]);
+        } else {
+            for (const Slot& s : slots)
+                if (s.key != EMPTY_KEY) f(static_cast<int>(s.key % width), static_cast<int>(s.key / width), s.count);
+        }
+    }
+
+    // Pirámide de sumas/máximos por bloques 2x2 para vistas alejadas.
+    // Desactivada por defecto; activa, cada visita la actualiza en O(log N).
+    void enablePyramid();
+    const MipPyramid* getPyramid() const { return pyramid ? &*pyramid : nullptr; }
+
+    // Modo de almacenamiento actual y memoria usada (bytes)
+    bool isDense() const { return dense; }
+    size_t bytesUsed() const;
+
 private:
+    static constexpr std::uint32_t EMPTY_KEY = 0xffffffffu;
+
+    struct Slot {
+        std::uint32_t key = EMPTY_KEY;   // id de celda
+        std::int32_t count = 0;
+    };
+
     int width, height;
     
-    std::unordered_map<Coord, int, CoordHash> visitCounts;
+    bool dense = false;
+    std::vector<std::int32_t> denseCounts;   // Modo denso: [y * width + x]
+    std::vector<Slot> slots;                 // Modo disperso: potencia de 2
+    int slotShift = 0;                       // 64 - log2(slots.size())
+    
+    // Contadores mantenidos al insertar
+    int uniqueCells = 0;
+    int totalVisits = 0;
+    int maxVisits = 0;
+    
+    // Celdas modificadas desde el último writeRGBA() (estado del renderer: mutable)
+    bool dirtyTracking = false;
+    mutable std::vector<std::uint32_t> dirtyCells;
+    mutable std::vector<std::uint64_t> dirtyBits;
+    mutable int paintedMax = -1;             // Máximo usado en el último pintado (-1 = nunca)
+    
+    std::optional<MipPyramid> pyramid;
     
-    mutable int cachedMaxVisits = -1; 
-};
\ No newline at end of file
+    size_t sparseLimit() const;  // Celdas únicas a partir de las cuales conviene denso
+    size_t slotIndex(std::uint32_t key) const {
+        return static_cast<size_t>((key * 0x9e3779b97f4a7c15ULL) >> slotShift);
+    }
+    void initSlots(size_t capacity);
+    std::int32_t& sparseCounter(std::uint32_t key);
+    void growSlots();
+    void switchToDense();
+};
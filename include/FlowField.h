@@ -0,0 +1,61 @@
+#pragma once
+#include "Grid.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Campo de flujo hacia una meta común.
+ * Un BFS desde la meta da la distancia de cada celda y la dirección del
+ * siguiente paso; cualquier cantidad de agentes avanza en O(1) por tick con
+ * nextStep(). Cuando cambian paredes (Origin Shift), update() repara solo la
+ * zona afectada en vez de recalcular todo el campo.
+ */
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    FlowField(const Grid& grid, Coord goal);
+
+    // Cambiar la meta (recalcula todo)
+    void setGoal(Coord goal);
+    Coord getGoal() const { return goal; }
+
+    // Recalcular todo el campo (BFS desde la meta)
+    void rebuild();
+
+    // Reparación incremental: celdas cuyas paredes cambiaron desde el último
+    // rebuild/update. Las distancias que empeoran se invalidan por subárbol y
+    // se recalculan desde el borde; las que mejoran se propagan desde las
+    // aristas nuevas. Retorna cuántas celdas cambiaron de distancia.
+    int update(const std::vector<Coord>& changedCells);
+
+    // Distancia en pasos hasta la meta (UNREACHABLE si no hay camino)
+    int getDistance(int x, int y) const {
+        int d = dist[index(x, y)];
+        return d == INF ? UNREACHABLE : d;
+    }
+    // Dirección del siguiente paso (0=Up,1=Left,2=Right,3=Down), -1 en la meta o sin camino
+    int getDirection(int x, int y) const { return dir[index(x, y)]; }
+
+    // Siguiente celda hacia la meta (la misma celda si está en la meta o sin camino)
+    Coord nextStep(Coord from) const;
+
+    int getMaxDistance() const;
+
+    // Distancias normalizadas [x][y] para el renderer del heatmap:
+    // 0 = sin camino, (d+1)/(max+1) en otro caso
+    std::vector<std::vector<float>> toNormalizedGrid() const;
+
+private:
+    static constexpr int INF = 0x3fffffff;
+
+    const Grid& g;
+    Coord goal;
+    int w, h;
+
+    std::vector<int> dist;
+    std::vector<std::int8_t> dir;
+
+    int index(int x, int y) const { return y * w + x; }
+    bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < w && y < h; }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/**
+ * Generador mínimo sobre corrutinas C++20.
+ * El cuerpo corre hasta cada co_yield; next() lo reanuda una vez y value()
+ * devuelve lo último producido. También se puede recorrer con range-for
+ * (bucle apretado sin llamadas virtuales).
+ */
+template <typename T>
+class Generator {
+public:
+    struct promise_type {
+        T current{};
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T value) {
+            current = std::move(value);
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator() { if (handle) handle.destroy(); }
+
+    // Reanudar hasta el siguiente co_yield; false si el cuerpo terminó
+    bool next() {
+        if (!handle || handle.done()) return false;
+        handle.resume();
+        rethrowIfFailed();
+        return !handle.done();
+    }
+
+    bool done() const { return !handle || handle.done(); }
+    const T& value() const { return handle.promise().current; }
+
+    // ---- range-for ----
+    struct Sentinel {};
+    class Iterator {
+    public:
+        explicit Iterator(Generator* g) : gen(g) {}
+        const T& operator*() const { return gen->value(); }
+        Iterator& operator++() { gen->next(); return *this; }
+        bool operator==(Sentinel) const { return gen->done(); }
+    private:
+        Generator* gen;
+    };
+
+    Iterator begin() { next(); return Iterator(this); }
+    Sentinel end() { return {}; }
+
+private:
+    explicit Generator(Handle h) : handle(h) {}
+
+    void rethrowIfFailed() {
+        if (handle.promise().error) std::rethrow_exception(handle.promise().error);
+    }
+
+    Handle handle;
+};
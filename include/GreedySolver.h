@@ -2,13 +2,15 @@
 #define GREEDY_SOLVER_H
 
 #include "Grid.h"
+#include "CompactSearchState.h"
+#include "SearchStats.h"
 #include <vector>
 #include <queue>
 #include <limits>
 
 class GreedySolver {
 public:
-    GreedySolver(Grid &grid, Coord start, Coord goal);
+    GreedySolver(const Grid &grid, Coord start, Coord goal);
 
     bool step();
 
@@ -18,18 +20,19 @@ public:
 
     // visualization helpers (like AStar)
     enum CellState { UNKNOWN = 0, OPEN = 1, CLOSED = 2 };
-    const std::vector<std::vector<CellState>> &getStateGrid() const { return stateGrid; }
-    const std::vector<std::vector<float>> &getGScoreGrid() const { return gScore; }
+    std::vector<std::vector<CellState>> getStateGrid() const { return state.decodeStateGrid<CellState>(); }
+    std::vector<std::vector<float>> getGScoreGrid() const { return state.decodeDistanceGrid(); }
+
+    // Contadores de esta resolución
+    SearchStats getSearchStats() const;
 
 private:
-    Grid &g;
+    const Grid &g;
     Coord start;
     Coord goal;
 
-    std::vector<std::vector<CellState>> stateGrid;
-    std::vector<std::vector<bool>> closed;
-    std::vector<std::vector<float>> gScore;
-    std::vector<std::vector<Coord>> cameFrom;
+    // Estado/closed/gScore/cameFrom compactos (bits + distancias enteras)
+    CompactSearchState state;
 
     struct PQNode { float h; int id; int x; int y; };
     struct Compare {
@@ -41,6 +44,9 @@ private:
     std::priority_queue<PQNode, std::vector<PQNode>, Compare> openPQ;
     int pushCounter = 0;
 
+    SearchStats stats;
+    PhaseSpan searchSpan;  // Búsqueda: se abre en el primer step() y se cierra al terminar
+
     bool done = false;
     bool solved = false;
     std::vector<Coord> solution;
@@ -1,4 +1,7 @@
 #pragma once
+#include "MipPyramid.h"
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 struct Cell {
@@ -34,8 +37,47 @@ public:
     // checks if moving in a certain direction is possible
     bool canMove(int x, int y, int dir) const;
 
+    // Hash del estado de paredes (Zobrist: XOR de una clave por pasaje abierto).
+    // removeWall/resetWalls lo mantienen en O(1); si se editan paredes
+    // directamente vía at(), llamar a rehashWalls().
+    std::uint64_t wallHash() const { return m_wallHash; }
+    // Pasajes abiertos entre celdas vecinas (aristas del grafo), mantenido igual que el hash
+    int openPassageCount() const { return m_openPassages; }
+    // Volver a poner todas las paredes
+    void resetWalls();
+    // Recalcular el hash desde cero (y la pirámide de paredes, si está activa)
+    void rehashWalls();
+
+    // Pirámide de densidad de paredes (paredes por celda, 0..4) para vistas
+    // alejadas y conteos O(1). Desactivada por defecto; una vez activa,
+    // removeWall la actualiza en O(log N).
+    void enableWallPyramid();
+    const MipPyramid* wallPyramid() const { return m_wallPyramid ? &*m_wallPyramid : nullptr; }
+
+    // Versiones de las líneas de paredes, para redibujar solo lo que cambió (WallMesh).
+    // Línea horizontal k: borde superior de la fila k (k = height: borde inferior).
+    // Línea vertical k: borde izquierdo de la columna k (k = width: borde derecho).
+    // removeWall sube la versión de la línea que tocó; resetWalls/rehashWalls, todas.
+    std::uint64_t wallVersion() const { return m_wallVersion; }
+    std::uint32_t horizontalLineVersion(int k) const { return m_hLineVersion[k]; }
+    std::uint32_t verticalLineVersion(int k) const { return m_vLineVersion[k]; }
+
 private:
     int m_width;
     int m_height;
     std::vector<std::vector<Cell>> m_grid; // indexed as m_grid[row][col] == m_grid[y][x]
+    std::uint64_t m_wallHash;
+    int m_openPassages = 0;
+    std::optional<MipPyramid> m_wallPyramid;
+    std::uint64_t m_wallVersion = 0;
+    std::vector<std::uint32_t> m_hLineVersion;  // height + 1 líneas
+    std::vector<std::uint32_t> m_vLineVersion;  // width + 1 líneas
+
+    // Hash con todas las paredes puestas (depende solo de las dimensiones)
+    std::uint64_t emptyHash() const;
+    // Clave del pasaje entre (x,y) y su vecino derecho (axis 0) o inferior (axis 1)
+    std::uint64_t edgeKey(int x, int y, int axis) const;
+    std::uint32_t wallCount(int x, int y) const;
+    void rebuildWallPyramid();
+    void touchAllWallLines();
 };
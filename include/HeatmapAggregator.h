@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ExplorationHeatmap;
+
+/**
+ * Heatmap agregado sobre muchas corridas (p.ej. todas las del ranking para
+ * una estrategia).
+ *
+ * Cada hilo escribe en su propio shard (sin locks ni atómicos); los shards
+ * están alineados a línea de caché para que sus encabezados no compartan
+ * línea, y sus contadores viven en buffers separados. merge() suma los
+ * shards en el total. save()/load() guardan el total en binario para
+ * comparar mapas entre sesiones.
+ *
+ * Formato: "MZHM" | versión u32 | ancho u32 | alto u32 | corridas u64 |
+ *          contadores u64 [alto][ancho] (endianness nativa)
+ */
+class HeatmapAggregator {
+public:
+    struct alignas(64) Shard {
+        std::vector<std::uint64_t> counts;  // [y * ancho + x]
+        std::uint64_t runs = 0;
+        int width = 0;
+
+        // Sumar una corrida completa
+        void add(const ExplorationHeatmap& heatmap);
+        void add(int x, int y, std::uint64_t visits) {
+            counts[static_cast<size_t>(y) * width + x] += visits;
+        }
+    };
+
+    HeatmapAggregator(int width, int height, int shardCount = 1);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getShardCount() const { return static_cast<int>(shards.size()); }
+
+    // Shard exclusivo de un hilo (índice de worker)
+    Shard& shard(int index) { return shards[index]; }
+
+    // Sumar todos los shards al total y vaciarlos
+    void merge();
+    // Sumar otro agregado (mismo tamaño) al total
+    bool mergeFrom(const HeatmapAggregator& other);
+    void clear();
+
+    std::uint64_t getRuns() const { return runs; }
+    std::uint64_t getVisits(int x, int y) const { return totals[static_cast<size_t>(y) * width + x]; }
+    std::uint64_t getMaxVisits() const;
+    std::uint64_t getTotalVisits() const;
+
+    // Total normalizado [x][y] en [0, 1] (mismo formato que ExplorationHeatmap)
+    std::vector<std::vector<float>> toNormalizedGrid() const;
+
+    // Guardar / cargar el total (load reemplaza el total actual)
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    int width, height;
+    std::vector<Shard> shards;
+    std::vector<std::uint64_t> totals;
+    std::uint64_t runs = 0;
+};
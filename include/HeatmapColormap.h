@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Paleta del heatmap precalculada (LUT de 256 colores RGBA).
+ * Entrada 0 = celda sin datos; 1..255 = gradiente azul -> verde -> amarillo -> rojo
+ * para intensidades (0, 1]. Los renderers escriben píxeles con una búsqueda
+ * en tabla en vez de evaluar el gradiente por celda.
+ */
+namespace HeatmapColormap {
+
+constexpr int LUT_SIZE = 256;
+using RGBA = std::array<std::uint8_t, 4>;
+
+inline const std::array<RGBA, LUT_SIZE>& lut() {
+    static const std::array<RGBA, LUT_SIZE> table = [] {
+        std::array<RGBA, LUT_SIZE> t{};
+        t[0] = {10, 10, 10, 255};  // No visitado
+        for (int i = 1; i < LUT_SIZE; ++i) {
+            float intensity = static_cast<float>(i) / (LUT_SIZE - 1);
+            float r, g, b;
+            if (intensity < 0.33f) {
+                float k = intensity / 0.33f;
+                r = 0; g = k * 100; b = 100 + k * 155;
+            } else if (intensity < 0.66f) {
+                float k = (intensity - 0.33f) / 0.33f;
+                r = k * 255; g = 100 + k * 155; b = 255 - k * 255;
+            } else {
+                float k = (intensity - 0.66f) / 0.34f;
+                r = 255; g = 255 - k * 100; b = 0;
+            }
+            t[i] = {static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g),
+                    static_cast<std::uint8_t>(b), 255};
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Índice de la LUT para 'value' sobre 'maxValue' (0 = sin datos)
+inline int indexFor(int value, int maxValue) {
+    if (value <= 0 || maxValue <= 0) return 0;
+    int i = static_cast<int>((static_cast<long long>(value) * (LUT_SIZE - 1) + maxValue / 2) / maxValue);
+    return i < 1 ? 1 : (i > LUT_SIZE - 1 ? LUT_SIZE - 1 : i);
+}
+
+inline void writePixel(std::uint8_t* pixels, std::size_t cell, int lutIndex) {
+    const RGBA& c = lut()[lutIndex];
+    std::uint8_t* p = pixels + cell * 4;
+    p[0] = c[0]; p[1] = c[1]; p[2] = c[2]; p[3] = c[3];
+}
+
+// Grid [x][y] normalizado a [0, 1] -> píxeles RGBA fila por fila (ancho*alto*4)
+inline void writeNormalized(const std::vector<std::vector<float>>& grid, std::uint8_t* pixels) {
+    int w = static_cast<int>(grid.size());
+    int h = w > 0 ? static_cast<int>(grid[0].size()) : 0;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float v = grid[x][y];
+            int i = v <= 0.0f ? 0 : static_cast<int>(v * (LUT_SIZE - 1) + 0.5f);
+            if (v > 0.0f && i < 1) i = 1;
+            if (i > LUT_SIZE - 1) i = LUT_SIZE - 1;
+            writePixel(pixels, static_cast<std::size_t>(y) * w + x, i);
+        }
+    }
+}
+
+}  // namespace HeatmapColormap
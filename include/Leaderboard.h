@@ -0,0 +1,152 @@
+#pragma once
+#include "AlgorithmRankingAVL.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Ranking persistente entre sesiones: ingiere cada corrida individual (no
+ * solo promedios) y ordena los algoritmos por el promedio acumulado.
+ *
+ * Disco (endianness nativa):
+ *   <base>.log  - log append-only de corridas
+ *                 "MZLL" | versión u32 | generación u64 |
+ *                 { largo u16 | nombre | nodos i32 | camino i32 | tiempo f32 | tesoros i32 }*
+ *   <base>.snap - snapshot compactado de los totales por algoritmo
+ *                 "MZLS" | versión u32 | generación u64 | entradas u32 |
+ *                 { largo u16 | nombre | corridas u64 | nodos i64 | camino i64 |
+ *                   tiempo f64 | tesoros i64 }*
+ *
+ * Al abrir se mapea el snapshot (mmap) y se reproduce el log encima. compact()
+ * escribe un snapshot nuevo (tmp + rename) con la generación siguiente y
+ * reinicia el log; un log de una generación vieja se ignora, así que un corte
+ * entre ambos pasos no cuenta corridas dos veces. Un registro cortado al final
+ * del log se descarta.
+ *
+ * Lectores: snapshot() devuelve una vista inmutable sin tomar locks. La
+ * vista se publica con un puntero crudo atómico (std::atomic<std::shared_ptr>
+ * usa un spinlock interno en libstdc++) y los nodos reemplazados se liberan
+ * con hazard pointers: el lector anuncia el nodo que va a leer, revalida el
+ * puntero y copia el shared_ptr de adentro; el escritor solo borra nodos
+ * retirados que ningún lector anunció. El escritor (record() o el hilo de
+ * startWriter()) es uno solo.
+ */
+struct LeaderboardEntry {
+    AlgorithmStats stats;      // Promedios acumulados (sin SearchStats)
+    std::uint64_t runs = 0;
+    int rank = 0;              // 1 = mejor
+};
+
+class LeaderboardSnapshot {
+public:
+    const std::vector<LeaderboardEntry>& getAll() const { return entries; }
+    int size() const { return static_cast<int>(entries.size()); }
+    std::uint64_t getTotalRuns() const { return totalRuns; }
+    // Número de publicación (crece con cada snapshot publicado)
+    std::uint64_t getVersion() const { return version; }
+
+private:
+    friend class Leaderboard;
+    std::vector<LeaderboardEntry> entries;  // Ordenadas por ranking
+    std::uint64_t totalRuns = 0;
+    std::uint64_t version = 0;
+};
+
+class Leaderboard {
+public:
+    // basePath sin extensión: se usan basePath + ".log" y basePath + ".snap"
+    explicit Leaderboard(std::string basePath);
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    // Cargar snapshot + log y dejar el log abierto para agregar. false si no se
+    // pudo abrir el log (el ranking sigue funcionando solo en memoria)
+    bool open();
+
+    // Ingerir una corrida (lado escritor, sincrónico)
+    void record(const AlgorithmStats& run);
+
+    // Hilo escritor: submit() encola y el hilo ingiere por lotes, publicando
+    // un snapshot por lote. stopWriter() vacía la cola antes de terminar.
+    void startWriter();
+    void submit(const AlgorithmStats& run);
+    void stopWriter();
+
+    // Vista inmutable más reciente (sin locks; seguro desde cualquier hilo)
+    std::shared_ptr<const LeaderboardSnapshot> snapshot() const;
+
+    // Publicar el estado actual para los lectores (lado escritor)
+    void publish();
+
+    // Reescribir el snapshot en disco y reiniciar el log (lado escritor)
+    bool compact();
+
+    // Compactar automáticamente cada N corridas en el log (0 = nunca)
+    void setCompactEvery(std::uint64_t runs) { compactEvery = runs; }
+
+    std::uint64_t getLogRuns() const { return logRuns; }
+
+private:
+    struct Totals {
+        std::uint64_t runs = 0;
+        std::int64_t nodesExpanded = 0;
+        std::int64_t pathLength = 0;
+        double executionTime = 0.0;
+        std::int64_t treasuresCollected = 0;
+
+        AlgorithmStats averaged(const std::string& name) const;
+    };
+
+    std::string logPath;
+    std::string snapPath;
+
+    // Estado del escritor
+    std::unordered_map<std::string, Totals> totals;
+    AlgorithmRankingAVL ranking;
+    std::ofstream log;
+    std::uint64_t generation = 0;
+    std::uint64_t logRuns = 0;
+    std::uint64_t totalRuns = 0;
+    std::uint64_t compactEvery = 4096;
+    std::uint64_t publishCount = 0;
+
+    // Publicación para lectores: nodo inmutable detrás de un puntero atómico
+    struct PublishedNode {
+        std::shared_ptr<const LeaderboardSnapshot> snap;
+    };
+    // Registro de hazard pointer: un lector lo toma mientras lee 'published'.
+    // Los registros se reutilizan y recién se liberan en el destructor
+    struct HazardRecord {
+        std::atomic<bool> active{false};
+        std::atomic<PublishedNode*> hazard{nullptr};
+        HazardRecord* next = nullptr;
+    };
+    std::atomic<PublishedNode*> published{nullptr};
+    mutable std::atomic<HazardRecord*> hazardRecords{nullptr};
+    std::vector<PublishedNode*> retired;  // Reemplazados aún anunciados por algún lector (escritor)
+
+    // Cola del hilo escritor (solo la comparten submit() y el hilo)
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::vector<AlgorithmStats> queue;
+    bool stopRequested = false;
+    std::thread writer;
+
+    void apply(const AlgorithmStats& run);
+    void appendToLog(const AlgorithmStats& run);
+    bool loadSnapshot();
+    void replayLog();
+    bool resetLog();
+    void writerLoop();
+    HazardRecord* acquireHazard() const;
+    void reclaimRetired();
+};
@@ -8,4 +8,6 @@ struct MazeAlgorithm {
     virtual bool finished() const = 0;
     // optional: provide a cell to highlight (for UI)
     virtual bool getCurrent(Coord &out) const { (void)out; return false; }
+    // run to completion without visualization (generators may override with a tighter loop)
+    virtual void runToEnd() { while (!finished()) step(); }
 };
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 #include "Grid.h"
+#include "CompactSearchState.h"
+#include "SearchStats.h"
 #include <stack>
 #include <vector>
 
 class MazeSolver {
 public:
-    MazeSolver(Grid &grid, Coord start, Coord goal);
+    MazeSolver(const Grid &grid, Coord start, Coord goal);
 
     // Ejecuta un paso del algoritmo DFS
     bool step();
@@ -19,15 +21,20 @@ public:
     // Devuelve el camino completo si se resolvió
     const std::vector<Coord> &getSolution() const;
 
-    const std::vector<std::vector<bool>> &getVisited() const { return visited; }
+    std::vector<std::vector<bool>> getVisited() const { return state.decodeReachedGrid(); }
+
+    // Contadores de esta resolución (pila = frontera)
+    SearchStats getSearchStats() const;
 
 private:
-    Grid &g;
+    const Grid &g;
     Coord start;
     Coord goal;
     std::stack<Coord> path;
-    std::vector<std::vector<bool>> visited;
-    std::vector<std::vector<Coord>> cameFrom;
+    // visited = celda alcanzada; cameFrom = dirección de 2 bits
+    CompactSearchState state;
     std::vector<Coord> solution;
     bool solved = false;
+    SearchStats stats;
+    PhaseSpan searchSpan;  // Búsqueda: se abre en el primer step() y se cierra al terminar
 };
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Pirámide de resoluciones (mipmap) sobre un grid de contadores.
+ * Nivel 0 = valores por celda; cada celda del nivel k resume un bloque
+ * de 2x2 del nivel k-1 (suma y máximo). El último nivel es 1x1.
+ *
+ * Las actualizaciones de una celda tocan una entrada por nivel: O(log N).
+ * Las vistas alejadas y las estadísticas por región leen el nivel que
+ * corresponde al zoom en vez de recorrer todo el grid.
+ */
+class MipPyramid {
+public:
+    enum class Reduce { SUM, MAX };
+
+    MipPyramid(int width, int height);
+
+    // Sumar 'delta' a una celda (solo crece: el máximo se actualiza sin releer hijos)
+    void add(int x, int y, std::uint32_t delta);
+    // Fijar el valor de una celda (puede bajar: el máximo se recalcula de los 4 hijos por nivel)
+    void set(int x, int y, std::uint32_t value);
+    // Reemplazar todo el nivel 0 (fila por fila) y reconstruir: O(N)
+    void assign(const std::vector<std::uint32_t>& values);
+    void clear();
+
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+    int levelWidth(int level) const { return levels[level].width; }
+    int levelHeight(int level) const { return levels[level].height; }
+
+    std::uint64_t getSum(int level, int x, int y) const;
+    std::uint32_t getMax(int level, int x, int y) const;
+    std::uint32_t getValue(int x, int y) const { return base[index0(x, y)]; }
+
+    // Totales (raíz de la pirámide): O(1)
+    std::uint64_t getTotal() const { return getSum(getLevelCount() - 1, 0, 0); }
+    std::uint32_t getGlobalMax() const { return getMax(getLevelCount() - 1, 0, 0); }
+
+    // Nivel más fino cuya resolución cabe en maxWidth x maxHeight
+    int levelToFit(int maxWidth, int maxHeight) const;
+
+    // Colores RGBA (HeatmapColormap) de un nivel, normalizados por el máximo
+    // de ese nivel; buffer de levelWidth * levelHeight * 4 bytes
+    void writeRGBA(int level, Reduce reduce, std::uint8_t* pixels) const;
+
+    size_t bytesUsed() const;
+
+private:
+    // Niveles >= 1 (el nivel 0 vive en 'base')
+    struct Level {
+        int width = 0, height = 0;
+        std::vector<std::uint64_t> sums;
+        std::vector<std::uint32_t> maxes;
+    };
+
+    int w, h;
+    std::vector<std::uint32_t> base;
+    std::vector<Level> levels;   // levels[0] solo guarda dimensiones
+
+    size_t index0(int x, int y) const { return static_cast<size_t>(y) * w + x; }
+    size_t indexOf(int level, int x, int y) const {
+        return static_cast<size_t>(y) * levels[level].width + x;
+    }
+    // Máximo de los (hasta 4) hijos de la celda (x, y) del nivel 'level'
+    std::uint32_t childMax(int level, int x, int y) const;
+    void rebuildLevels();
+};
@@ -24,6 +24,10 @@ public:
     // Sincronizar paredes del Grid según parentMap
     void applyToGrid();
     
+    // Celdas cuyas paredes cambiaron en el último applyToGrid()
+    // (para reparar incrementalmente estructuras derivadas, p.ej. FlowField)
+    const std::vector<Coord>& getChangedCells() const { return changedCells; }
+    
     // Inicializar el árbol dirigido desde el laberinto existente
     void initializeFromMaze();
     
@@ -42,6 +46,10 @@ private:
     
     std::mt19937 rng;
     
+    // Celdas tocadas por update() desde el último applyToGrid()
+    std::vector<Coord> pendingChanges;
+    std::vector<Coord> changedCells;
+    
     // Obtener vecinos válidos (celdas adyacentes dentro del grid)
     std::vector<std::pair<Coord, int>> getNeighbors(const Coord& c) const;
     
@@ -0,0 +1,65 @@
+#pragma once
+#include "Grid.h"
+#include "SolverStrategy.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Caché LRU de caminos resueltos: (hash del laberinto, inicio, meta, estrategia) -> camino.
+ * El hash viene de Grid::wallHash(), así que cualquier cambio de paredes
+ * invalida naturalmente las entradas viejas (dejan de coincidir y salen por LRU).
+ * No es thread-safe: usar una instancia por hilo.
+ */
+struct PathCacheKey {
+    std::uint64_t mazeHash = 0;
+    Coord start;
+    Coord goal;
+    SolverStrategy strategy = SolverStrategy::ASTAR;
+
+    bool operator==(const PathCacheKey& o) const {
+        return mazeHash == o.mazeHash && start == o.start && goal == o.goal && strategy == o.strategy;
+    }
+};
+
+struct PathCacheKeyHash {
+    std::size_t operator()(const PathCacheKey& k) const;
+};
+
+class PathCache {
+public:
+    explicit PathCache(size_t capacity = 256);
+
+    // Buscar un camino; si existe, lo copia en out y lo marca como el más reciente
+    bool get(const PathCacheKey& key, std::vector<Coord>& out);
+
+    // Guardar (o reemplazar) un camino; expulsa el menos usado si está lleno
+    void put(const PathCacheKey& key, const std::vector<Coord>& path);
+
+    void clear();
+
+    size_t size() const { return index.size(); }
+    size_t getCapacity() const { return capacity; }
+
+    // Estadísticas
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    long long getEvictions() const { return evictions; }
+    float getHitRate() const;
+
+private:
+    struct Entry {
+        PathCacheKey key;
+        std::vector<Coord> path;
+    };
+
+    size_t capacity;
+    std::list<Entry> entries;  // frente = más reciente
+    std::unordered_map<PathCacheKey, std::list<Entry>::iterator, PathCacheKeyHash> index;
+
+    long long hits = 0;
+    long long misses = 0;
+    long long evictions = 0;
+};
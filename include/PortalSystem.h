@@ -8,6 +8,10 @@
  * Sistema de Portales Bidireccionales (Tipo ATAJO)
  * Cada portal conecta dos puntos A y B del laberinto.
  * Si estás en A, puedes saltar a B (y viceversa).
+ *
+ * Los portales se exponen como aristas extra del grafo (costo 1) mediante
+ * una tabla densa por celda, así que las consultas son O(1) sin importar
+ * cuántos portales existan.
  */
 struct Portal {
     Coord a;  // Punto A
@@ -17,21 +21,46 @@ struct Portal {
 class PortalSystem {
 public:
     PortalSystem(int gridW, int gridH);
-    
+
     // Generar portales aleatorios evitando start/goal
     void generatePortals(const Coord& start, const Coord& goal, int count = 2);
-    
-    // Si pos es entrada de un portal, retorna su salida
+
+    // Registrar un portal concreto (false si colisiona o está fuera del grid)
+    bool addPortal(const Coord& a, const Coord& b);
+
+    // Eliminar todos los portales
+    void clear();
+
+    // Si pos es entrada de un portal, retorna su salida (O(1))
     std::optional<Coord> getPortalExit(const Coord& pos) const;
-    
+
     // Para visualización
     const std::vector<Portal>& getPortals() const { return portals; }
-    
-    // Verificar si una posición es parte de un portal
+
+    // Verificar si una posición es parte de un portal (O(1))
     bool isPortalCell(const Coord& pos) const;
-    
+
+    // Distancia Manhattan a la boca de portal más cercana (O(1))
+    int nearestPortalDistance(const Coord& pos) const;
+
+    // Heurística admisible y consistente hacia goal considerando portales:
+    // min(Manhattan directa, dist a una boca + 1 salto + dist de una boca a goal)
+    float heuristic(const Coord& pos, const Coord& goal) const;
+
 private:
     int width, height;
     std::vector<Portal> portals;
     std::mt19937 rng;
+
+    // exitCell[y * width + x] = id de la celda de salida, -1 si no es portal
+    std::vector<int> exitCell;
+
+    // portalDistance[id] = distancia L1 a la boca de portal más cercana
+    std::vector<int> portalDistance;
+
+    int cellId(const Coord& c) const { return c.y * width + c.x; }
+    bool inBounds(const Coord& c) const;
+
+    // Propagar distancias desde una nueva boca (solo celdas que mejoran)
+    void relaxPortalDistance(const Coord& seed);
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include "Grid.h"
+#include "SolverStrategy.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Portfolio Solver: corre varias estrategias en paralelo (un hilo por
+ * estrategia) sobre el MISMO grid de solo lectura. La primera que entrega
+ * un camino gana y las demás se cancelan de forma cooperativa (revisan una
+ * bandera atómica entre pasos).
+ */
+struct PortfolioResult {
+    bool solved = false;
+    SolverStrategy winner = SolverStrategy::ASTAR;
+    std::vector<Coord> path;
+    float elapsedTime = 0.0f;   // Segundos hasta que el ganador entregó el camino
+    int winnerSteps = 0;        // Pasos que dio el ganador
+};
+
+class PortfolioSolver {
+public:
+    PortfolioSolver(const Grid& grid, Coord start, Coord goal,
+                    std::vector<SolverStrategy> strategies = {
+                        SolverStrategy::ASTAR, SolverStrategy::GREEDY,
+                        SolverStrategy::UCS, SolverStrategy::DFS,
+                        SolverStrategy::DEADEND_FILL });
+
+    // Lanzar la carrera y esperar al ganador (bloqueante)
+    PortfolioResult solve();
+
+private:
+    const Grid& g;
+    Coord start;
+    Coord goal;
+    std::vector<SolverStrategy> strategies;
+};
+
+// Conteo de victorias por tipo de generador (para estadísticas)
+class PortfolioStats {
+public:
+    void recordWin(const std::string& generator, SolverStrategy winner);
+
+    int getWins(const std::string& generator, SolverStrategy strategy) const;
+    int getRaces(const std::string& generator) const;
+
+    // generador -> (estrategia -> victorias)
+    const std::map<std::string, std::map<SolverStrategy, int>>& getAll() const { return wins; }
+
+private:
+    std::map<std::string, std::map<SolverStrategy, int>> wins;
+};
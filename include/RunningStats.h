@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Estadísticas en línea (una pasada, memoria constante) para agregar corridas
+ * de benchmark sin guardar las muestras.
+ *
+ * - Welford: media y varianza numéricamente estables, más mínimo y máximo.
+ * - P2Quantile: estimador P² (Jain & Chlamtac) de un cuantil con 5 marcadores.
+ *   Las primeras EXACT_SAMPLES muestras se guardan y el valor es exacto; al
+ *   llenarse, los marcadores arrancan desde esas muestras ordenadas (así p95/p99
+ *   no parten de la mediana con pocas corridas).
+ * - MetricSummary: Welford + p50/p95/p99 de una misma métrica.
+ */
+class Welford {
+public:
+    void add(double x);
+
+    std::uint64_t count() const { return n; }
+    double getMean() const { return mean; }
+    double getVariance() const { return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0; }  // Muestral
+    double getStdDev() const;
+    double getMin() const { return min; }
+    double getMax() const { return max; }
+
+private:
+    std::uint64_t n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;  // Suma de cuadrados de desvíos
+    double min = 0.0;
+    double max = 0.0;
+};
+
+class P2Quantile {
+public:
+    explicit P2Quantile(double p = 0.5);
+
+    void add(double x);
+    double value() const;
+    std::uint64_t count() const { return n; }
+
+    static constexpr int EXACT_SAMPLES = 64;
+
+private:
+    double p;
+    std::uint64_t n = 0;
+    double samples[EXACT_SAMPLES] = {};  // Primeras muestras (cuantil exacto)
+    double q[5] = {};       // Alturas de los marcadores
+    double pos[5] = {};     // Posiciones actuales
+    double desired[5] = {}; // Posiciones deseadas
+    double step[5] = {};    // Incremento de las posiciones deseadas por muestra
+
+    void initMarkers();
+    double parabolic(int i, double d) const;
+    double linear(int i, int d) const;
+};
+
+// Resumen compacto de una distribución (lo que se guarda en el ranking)
+struct RunDistribution {
+    int runs = 0;
+    float mean = 0.0f;
+    float stdDev = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+};
+
+class MetricSummary {
+public:
+    MetricSummary() : p50(0.50), p95(0.95), p99(0.99) {}
+
+    void add(double x) {
+        moments.add(x);
+        p50.add(x);
+        p95.add(x);
+        p99.add(x);
+    }
+
+    const Welford& getMoments() const { return moments; }
+    RunDistribution summarize() const;
+
+private:
+    Welford moments;
+    P2Quantile p50;
+    P2Quantile p95;
+    P2Quantile p99;
+};
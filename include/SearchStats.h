@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * Contadores por resolución, comunes a todos los solvers.
+ * Se acumulan con += (peakOpen toma el máximo) y se promedian con averaged().
+ */
+struct SearchStats {
+    long long pushes = 0;          // Inserciones en la frontera (PQ / pila / cola)
+    long long pops = 0;            // Extracciones útiles de la frontera
+    long long stalePops = 0;       // Extracciones descartadas (celda ya CLOSED)
+    long long peakOpen = 0;        // Tamaño máximo de la frontera
+    long long reopenings = 0;      // Mejoras de g en celdas ya abiertas (entrada duplicada)
+    long long heuristicEvals = 0;  // Llamadas a la heurística
+    long long cacheHits = 0;       // Tramos servidos por la PathCache (sin búsqueda)
+    long long cachedCells = 0;     // Celdas recorridas en esos tramos (no cuentan como expandidas)
+    size_t bytesAllocated = 0;     // Memoria del estado + frontera (aprox.)
+
+    // Tiempo por fase (segundos)
+    double initTime = 0.0;         // Construcción / inicialización de segmentos
+    double searchTime = 0.0;       // Expansión de nodos (reloj de pared de la fase, ver PhaseSpan)
+    double reconstructTime = 0.0;  // Reconstrucción del camino
+
+    void notePush(size_t openSize) {
+        ++pushes;
+        peakOpen = std::max(peakOpen, static_cast<long long>(openSize));
+    }
+
+    SearchStats& operator+=(const SearchStats& o) {
+        pushes += o.pushes;
+        pops += o.pops;
+        stalePops += o.stalePops;
+        peakOpen = std::max(peakOpen, o.peakOpen);
+        reopenings += o.reopenings;
+        heuristicEvals += o.heuristicEvals;
+        cacheHits += o.cacheHits;
+        cachedCells += o.cachedCells;
+        bytesAllocated += o.bytesAllocated;
+        initTime += o.initTime;
+        searchTime += o.searchTime;
+        reconstructTime += o.reconstructTime;
+        return *this;
+    }
+
+    // Promedio de n resoluciones acumuladas (peakOpen se mantiene como máximo)
+    SearchStats averaged(int n) const {
+        SearchStats avg = *this;
+        if (n <= 0) return avg;
+        avg.pushes /= n;
+        avg.pops /= n;
+        avg.stalePops /= n;
+        avg.reopenings /= n;
+        avg.heuristicEvals /= n;
+        avg.cacheHits /= n;
+        avg.cachedCells /= n;
+        avg.bytesAllocated /= n;
+        avg.initTime /= n;
+        avg.searchTime /= n;
+        avg.reconstructTime /= n;
+        return avg;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const SearchStats& s) {
+    os << "push=" << s.pushes << " pop=" << s.pops << " stale=" << s.stalePops
+       << " peakOpen=" << s.peakOpen << " reopen=" << s.reopenings
+       << " h=" << s.heuristicEvals << " cache=" << s.cacheHits << "/" << s.cachedCells
+       << " bytes=" << s.bytesAllocated
+       << " t(init/search/path)=" << s.initTime * 1000.0 << "/"
+       << s.searchTime * 1000.0 << "/" << s.reconstructTime * 1000.0 << " ms";
+    return os;
+}
+
+// Cronómetro de fase: suma el tiempo transcurrido a 'target' en stop() o al destruirse
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double& target)
+        : target(&target), begin(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    void stop() {
+        if (!target) return;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        *target += elapsed.count();
+        target = nullptr;
+    }
+
+private:
+    double* target;
+    std::chrono::steady_clock::time_point begin;
+};
+
+// Fase repartida en muchos step(): un now() en el primer paso y otro al
+// cerrarla, en lugar de dos por expansión (que pesarían tanto como la
+// expansión misma). Mide reloj de pared entre begin() y end(), así que solo
+// es tiempo de búsqueda cuando step() se llama en un bucle apretado
+// (benchmarks); en modo visual incluye los frames intermedios.
+class PhaseSpan {
+public:
+    // Abrir la fase si no está abierta (los pasos siguientes solo cuestan un if)
+    void begin() {
+        if (running) return;
+        running = true;
+        start = std::chrono::steady_clock::now();
+    }
+
+    // Cerrar la fase y sumar lo transcurrido a 'target' (sin efecto si está cerrada)
+    void end(double& target) {
+        if (!running) return;
+        running = false;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        target += elapsed.count();
+    }
+
+private:
+    bool running = false;
+    std::chrono::steady_clock::time_point start;
+};
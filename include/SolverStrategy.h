@@ -0,0 +1,10 @@
+#pragma once
+
+// Estrategias de búsqueda disponibles para los solvers
+enum class SolverStrategy {
+    ASTAR,      
+    GREEDY,     
+    UCS,        
+    DFS,
+    DEADEND_FILL   // Relleno de callejones (sin búsqueda)
+};
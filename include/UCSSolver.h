@@ -2,13 +2,17 @@
 #define UCS_SOLVER_H
 
 #include "Grid.h"
+#include "PortalSystem.h"
+#include "CompactSearchState.h"
+#include "SearchStats.h"
 #include <vector>
 #include <queue>
 #include <limits>
 
 class UCSSolver {
 public:
-    UCSSolver(Grid &grid, Coord start, Coord goal);
+    // portals (opcional): los portales se expanden como aristas de costo 1
+    UCSSolver(const Grid &grid, Coord start, Coord goal, const PortalSystem *portals = nullptr);
 
     bool step();
 
@@ -17,18 +21,20 @@ public:
     const std::vector<Coord> &getSolution() const;
 
     enum CellState { UNKNOWN = 0, OPEN = 1, CLOSED = 2 };
-    const std::vector<std::vector<CellState>> &getStateGrid() const { return stateGrid; }
-    const std::vector<std::vector<float>> &getGScoreGrid() const { return gScore; }
+    std::vector<std::vector<CellState>> getStateGrid() const { return state.decodeStateGrid<CellState>(); }
+    std::vector<std::vector<float>> getGScoreGrid() const { return state.decodeDistanceGrid(); }
+
+    // Contadores de esta resolución
+    SearchStats getSearchStats() const;
 
 private:
-    Grid &g;
+    const Grid &g;
     Coord start;
     Coord goal;
+    const PortalSystem *portals;
 
-    std::vector<std::vector<CellState>> stateGrid;
-    std::vector<std::vector<bool>> closed;
-    std::vector<std::vector<float>> gScore;
-    std::vector<std::vector<Coord>> cameFrom;
+    // Estado/closed/gScore/cameFrom compactos (bits + distancias enteras)
+    CompactSearchState state;
 
     struct PQNode { float cost; int id; int x; int y; };
     struct Compare {
@@ -40,11 +46,16 @@ private:
     std::priority_queue<PQNode, std::vector<PQNode>, Compare> openPQ;
     int pushCounter = 0;
 
+    SearchStats stats;
+    PhaseSpan searchSpan;  // Búsqueda: se abre en el primer step() y se cierra al terminar
+
     bool done = false;
     bool solved = false;
     std::vector<Coord> solution;
     Coord current;
 
+    // dir = dirección del movimiento c->n, -1 si es un salto de portal
+    void relax(int cx, int cy, int nx, int ny, int dir);
     void reconstruct_path(int x, int y);
 };
 
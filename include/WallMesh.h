@@ -0,0 +1,49 @@
+#pragma once
+#include "Grid.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Paredes del laberinto en un único sf::VertexArray (Lines): todo el
+ * laberinto se dibuja con una sola llamada a draw, no una por pared.
+ *
+ * Las paredes contiguas sobre una misma línea de la grilla se unen en un solo
+ * segmento. Cada línea guarda sus tramos y la versión de Grid con la que se
+ * armó: update() rearma solo las líneas que cambiaron (removeWall sube la
+ * versión de una sola línea) y, si hubo alguna, vuelve a concatenar los
+ * vértices.
+ */
+class WallMesh {
+public:
+    WallMesh(const Grid& grid, float cellSize, sf::Color color);
+
+    // Sincronizar con las paredes actuales (casi gratis si no cambió nada)
+    void update();
+
+    // update() + una sola llamada a draw; offset desplaza todo el laberinto
+    void draw(sf::RenderTarget& target, sf::Vector2f offset = sf::Vector2f(0.0f, 0.0f));
+
+    size_t getSegmentCount() const { return segmentCount; }
+
+private:
+    struct Line {
+        std::uint32_t version = 0;
+        std::vector<std::pair<int, int>> runs;  // Tramos [desde, hasta) en celdas
+    };
+
+    const Grid& grid;
+    float cellSize;
+    sf::Color color;
+    std::vector<Line> horizontal;  // grid.height() + 1 líneas
+    std::vector<Line> vertical;    // grid.width() + 1 líneas
+    std::uint64_t builtVersion = 0;
+    bool built = false;
+    size_t segmentCount = 0;
+    sf::VertexArray vertices;
+
+    void buildHorizontal(int k);
+    void buildVertical(int k);
+    void rebuildVertices();
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Pool de hilos con robo de trabajo para lotes de tareas independientes.
+ *
+ * run(count, task) reparte los índices [0, count) en bloques contiguos, uno
+ * por worker. Cada worker consume su cola por el final (tareas vecinas, p.ej.
+ * varios solvers sobre el mismo laberinto, quedan en el mismo hilo) y, cuando
+ * se vacía, roba del frente de la cola de otro worker. Cada cola tiene su
+ * propio mutex y solo se toca una vez por tarea, así que la contención es
+ * mínima con tareas de grano grueso.
+ */
+class WorkStealingPool {
+public:
+    // threadCount = 0 usa std::thread::hardware_concurrency()
+    explicit WorkStealingPool(int threadCount = 0);
+
+    int getThreadCount() const { return threadCount; }
+
+    // Ejecutar task(índice, worker) para cada índice y esperar a que terminen.
+    // 'worker' está en [0, getThreadCount()) y sirve para datos por hilo.
+    void run(size_t count, const std::function<void(size_t index, int worker)>& task);
+
+    // Tareas robadas en el último run()
+    size_t getLastSteals() const { return lastSteals; }
+
+private:
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> items;
+        size_t steals = 0;
+    };
+
+    int threadCount;
+    size_t lastSteals = 0;
+
+    bool popLocal(WorkQueue& q, size_t& index);
+    bool steal(std::vector<WorkQueue>& queues, int thief, size_t& index);
+};
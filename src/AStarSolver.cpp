@@ -3,49 +3,71 @@
 #include <algorithm>
 #include <limits>
 
-AStarSolver::AStarSolver(Grid &grid, Coord s, Coord g_)
-    : g(grid), start(s), goal(g_),
-      stateGrid(grid.width(), std::vector<CellState>(grid.height(), UNKNOWN)),
-      closed(grid.width(), std::vector<bool>(grid.height(), false)),
-      gScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      fScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      cameFrom(grid.width(), std::vector<Coord>(grid.height(), Coord(-1,-1))),
+AStarSolver::AStarSolver(const Grid &grid, Coord s, Coord g_, const PortalSystem *portals_)
+    : g(grid), start(s), goal(g_), portals(portals_),
+      state(grid.width(), grid.height()),
       current(s) {
-
-    gScore[start.x][start.y] = 0.0f;
-    fScore[start.x][start.y] = heuristic(start.x, start.y);
-    openPQ.push({fScore[start.x][start.y], pushCounter++, start.x, start.y});
-    stateGrid[start.x][start.y] = OPEN;
+    PhaseTimer initTimer(stats.initTime);
+
+    state.setDistance(start.x, start.y, 0);
+    state.clearParent(start.x, start.y);
+    state.setState(start.x, start.y, CompactSearchState::OPEN);
+    openPQ.push({heuristic(start.x, start.y), pushCounter++, start.x, start.y});
+    stats.heuristicEvals++;
+    stats.notePush(openPQ.size());
 }
 
 float AStarSolver::heuristic(int x, int y) const {
+    if (portals) return portals->heuristic(Coord(x, y), goal);
     return static_cast<float>(std::abs(goal.x - x) + std::abs(goal.y - y));
 }
 
+void AStarSolver::relax(int cx, int cy, int nx, int ny, int dir) {
+    if (state.isClosed(nx, ny)) return;
+
+    std::uint32_t tentative_g = state.getDistance(cx, cy) + 1;
+
+    if (tentative_g < state.getDistance(nx, ny)) {
+        if (state.isReached(nx, ny)) stats.reopenings++;
+        if (dir >= 0) state.setParentDir(nx, ny, CompactSearchState::oppositeDir(dir));
+        else state.setParentPortal(nx, ny);
+        state.setState(nx, ny, CompactSearchState::OPEN); // mark as in open set
+        state.setDistance(nx, ny, tentative_g);
+        float f = static_cast<float>(tentative_g) + heuristic(nx, ny);
+        openPQ.push({f, pushCounter++, nx, ny});
+        stats.heuristicEvals++;
+        stats.notePush(openPQ.size());
+    }
+}
+
 bool AStarSolver::step() {
     if (done) return true;
+    searchSpan.begin();
     if (openPQ.empty()) {
         done = true;
         solved = false;
+        searchSpan.end(stats.searchTime);
         return true;
     }
 
     // pop best node, skip outdated
     PQNode node;
     do {
-        if (openPQ.empty()) { done = true; solved = false; return true; }
+        if (openPQ.empty()) { done = true; solved = false; searchSpan.end(stats.searchTime); return true; }
         node = openPQ.top();
         openPQ.pop();
-    } while (closed[node.x][node.y]);
+        if (state.isClosed(node.x, node.y)) stats.stalePops++;
+    } while (state.isClosed(node.x, node.y));
+    stats.pops++;
 
     int cx = node.x, cy = node.y;
     current = Coord(cx, cy);
 
-    // mark closed (update stateGrid)
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
+    // mark closed
+    state.setState(cx, cy, CompactSearchState::CLOSED);
 
     if (cx == goal.x && cy == goal.y) {
+        searchSpan.end(stats.searchTime);
         reconstruct_path(cx, cy);
         done = true;
         solved = true;
@@ -63,16 +85,13 @@ bool AStarSolver::step() {
         else if (dir == 3) ny += 1;
 
         if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
-
-        float tentative_g = gScore[cx][cy] + 1.0f;
+        relax(cx, cy, nx, ny, dir);
+    }
 
-        if (tentative_g < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_g;
-            fScore[nx][ny] = tentative_g + heuristic(nx, ny);
-            openPQ.push({fScore[nx][ny], pushCounter++, nx, ny});
-            stateGrid[nx][ny] = OPEN; // mark as in open set
+    // portal edge (cost 1, like any other move)
+    if (portals) {
+        if (auto exit = portals->getPortalExit(Coord(cx, cy))) {
+            relax(cx, cy, exit->x, exit->y, -1);
         }
     }
 
@@ -80,13 +99,8 @@ bool AStarSolver::step() {
 }
 
 void AStarSolver::reconstruct_path(int x, int y) {
-    solution.clear();
-    Coord cur(x, y);
-    while (!(cur.x == -1 && cur.y == -1)) {
-        solution.push_back(cur);
-        cur = cameFrom[cur.x][cur.y];
-    }
-    std::reverse(solution.begin(), solution.end());
+    PhaseTimer pathTimer(stats.reconstructTime);
+    solution = state.tracePath(Coord(x, y), portals);
 }
 
 bool AStarSolver::finished() const {
@@ -102,3 +116,10 @@ bool AStarSolver::getCurrent(Coord &out) const {
 const std::vector<Coord> &AStarSolver::getSolution() const {
     return solution;
 }
+
+SearchStats AStarSolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.bytesAllocated = state.bytesUsed() + static_cast<size_t>(stats.peakOpen) * sizeof(PQNode)
+                       + solution.size() * sizeof(Coord);
+    return out;
+}
@@ -0,0 +1,235 @@
+#include "AgentSystem.h"
+#include "ExplorationHeatmap.h"
+#include "FlowField.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+const int DX[4] = {0, -1, 1, 0};
+const int DY[4] = {-1, 0, 0, 1};
+}
+
+AgentSystem::AgentSystem(const Grid& grid, Coord goal_, int threads)
+    : g(grid), goal(goal_), w(grid.width()), h(grid.height()), threadCount(threads) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+    size_t cells = static_cast<size_t>(w) * h;
+    visitedWords = (cells + 63) / 64;
+    parentBytes = (cells + 3) / 4;
+    scratch.resize(threadCount);
+}
+
+int AgentSystem::addAgent(AgentKind k, Coord start, std::uint32_t seed) {
+    size_t agent = posX.size();
+    posX.push_back(start.x);
+    posY.push_back(start.y);
+    startX.push_back(start.x);
+    startY.push_back(start.y);
+    kind.push_back(static_cast<std::uint8_t>(k));
+    done.push_back(0);
+    rngState.push_back(seed ? seed : 0x9e3779b9u);  // xorshift no admite 0
+
+    visitedArena.resize(visitedArena.size() + visitedWords, 0);
+    parentArena.resize(parentArena.size() + parentBytes, 0);
+    markVisited(agent, start.y * w + start.x);
+
+    if (start.x == goal.x && start.y == goal.y) done[agent] = 1;
+    return static_cast<int>(agent);
+}
+
+void AgentSystem::spawnRandom(int count, AgentKind k, std::uint32_t seed) {
+    size_t first = posX.size();
+    posX.reserve(first + count);
+    posY.reserve(first + count);
+    startX.reserve(first + count);
+    startY.reserve(first + count);
+    kind.reserve(first + count);
+    done.reserve(first + count);
+    rngState.reserve(first + count);
+    visitedArena.reserve((first + count) * visitedWords);
+    parentArena.reserve((first + count) * parentBytes);
+
+    std::uint32_t r = seed ? seed : 1u;
+    for (int i = 0; i < count; ++i) {
+        r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+        int x = static_cast<int>(r % static_cast<std::uint32_t>(w));
+        r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+        int y = static_cast<int>(r % static_cast<std::uint32_t>(h));
+        addAgent(k, Coord(x, y), r * 2654435761u + static_cast<std::uint32_t>(i));
+    }
+}
+
+void AgentSystem::clear() {
+    posX.clear(); posY.clear();
+    startX.clear(); startY.clear();
+    kind.clear(); done.clear(); rngState.clear();
+    visitedArena.clear();
+    parentArena.clear();
+}
+
+int AgentSystem::getDoneCount() const {
+    int count = 0;
+    for (std::uint8_t d : done) count += d;
+    return count;
+}
+
+size_t AgentSystem::bytesPerAgent() const {
+    return 4 * sizeof(std::int32_t) + 2 * sizeof(std::uint8_t) + sizeof(std::uint32_t)
+         + visitedWords * sizeof(std::uint64_t) + parentBytes;
+}
+
+void AgentSystem::setParentDir(size_t agent, int cell, int dir) {
+    std::uint8_t& b = parentArena[agent * parentBytes + (cell >> 2)];
+    int shift = (cell & 3) * 2;
+    b = static_cast<std::uint8_t>((b & ~(3u << shift)) | (static_cast<unsigned>(dir) << shift));
+}
+
+std::uint32_t AgentSystem::nextRandom(size_t agent) {
+    std::uint32_t x = rngState[agent];
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    rngState[agent] = x;
+    return x;
+}
+
+int AgentSystem::stepExplorer(size_t agent, bool seeker) {
+    int x = posX[agent], y = posY[agent];
+    const Cell& cell = g.at(x, y);
+
+    // Vecinos abiertos no visitados (el agente solo "ve" su celda)
+    int options[4];
+    int count = 0;
+    for (int d = 0; d < 4; ++d) {
+        if (cell.walls[d]) continue;
+        int nx = x + DX[d], ny = y + DY[d];
+        if (nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+        if (visited(agent, ny * w + nx)) continue;
+        options[count++] = d;
+    }
+
+    int dir;
+    if (count > 0) {
+        if (seeker) {
+            // Menor distancia Manhattan a la meta; empates al azar
+            int best = -1, bestDist = 0, ties = 0;
+            for (int i = 0; i < count; ++i) {
+                int nx = x + DX[options[i]], ny = y + DY[options[i]];
+                int dist = std::abs(nx - goal.x) + std::abs(ny - goal.y);
+                if (best < 0 || dist < bestDist) {
+                    best = options[i]; bestDist = dist; ties = 1;
+                } else if (dist == bestDist && nextRandom(agent) % ++ties == 0) {
+                    best = options[i];
+                }
+            }
+            dir = best;
+        } else {
+            dir = options[nextRandom(agent) % count];
+        }
+
+        int nid = (y + DY[dir]) * w + (x + DX[dir]);
+        markVisited(agent, nid);
+        setParentDir(agent, nid, 3 - dir);
+    } else {
+        // Retroceder; en el origen sin opciones, la exploración terminó
+        if (x == startX[agent] && y == startY[agent]) {
+            done[agent] = 1;
+            return -1;
+        }
+        dir = parentDir(agent, y * w + x);
+    }
+
+    posX[agent] = x + DX[dir];
+    posY[agent] = y + DY[dir];
+    return posY[agent] * w + posX[agent];
+}
+
+int AgentSystem::stepFlow(size_t agent) {
+    if (!flow) return -1;
+    int x = posX[agent], y = posY[agent];
+    int dir = flow->getDirection(x, y);
+    if (dir < 0) {
+        done[agent] = 1;  // En la meta o sin camino
+        return -1;
+    }
+    posX[agent] = x + DX[dir];
+    posY[agent] = y + DY[dir];
+    int cell = posY[agent] * w + posX[agent];
+    markVisited(agent, cell);
+    return cell;
+}
+
+int AgentSystem::stepAgent(size_t agent) {
+    int cell;
+    switch (static_cast<AgentKind>(kind[agent])) {
+        case AgentKind::WANDERER: cell = stepExplorer(agent, false); break;
+        case AgentKind::SEEKER:   cell = stepExplorer(agent, true); break;
+        default:                  cell = stepFlow(agent); break;
+    }
+    if (posX[agent] == goal.x && posY[agent] == goal.y) done[agent] = 1;
+    return cell;
+}
+
+void AgentSystem::runRange(size_t begin, size_t end, int ticks, Scratch& s) {
+    size_t cells = static_cast<size_t>(w) * h;
+    if (s.visits.size() != cells) s.visits.assign(cells, 0);
+    s.touched.clear();
+    s.agentTicks = 0;
+
+    for (int t = 0; t < ticks; ++t) {
+        long long active = 0;
+        for (size_t a = begin; a < end; ++a) {
+            if (done[a]) continue;
+            active++;
+            int cell = stepAgent(a);
+            if (cell < 0) continue;
+            if (s.visits[cell]++ == 0) s.touched.push_back(cell);
+        }
+        s.agentTicks += active;
+        if (active == 0) break;
+    }
+}
+
+void AgentSystem::run(int ticks, ExplorationHeatmap* heatmap) {
+    size_t agents = posX.size();
+    lastAgentTicks = 0;
+    lastAgentTicksPerSecond = 0.0;
+    if (agents == 0 || ticks <= 0) return;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    // Rangos contiguos de agentes por hilo (cada hilo escribe solo su rango)
+    int workers = std::max(1, std::min(threadCount, static_cast<int>(agents)));
+    size_t chunk = (agents + workers - 1) / workers;
+    if (workers == 1) {
+        runRange(0, agents, ticks, scratch[0]);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int t = 0; t < workers; ++t) {
+            size_t begin = std::min(agents, t * chunk);
+            size_t end = std::min(agents, begin + chunk);
+            threads.emplace_back([this, begin, end, ticks, t]() { runRange(begin, end, ticks, scratch[t]); });
+        }
+        for (auto& th : threads) th.join();
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Volcar contadores por hilo al heatmap compartido
+    for (int t = 0; t < workers; ++t) {
+        Scratch& s = scratch[t];
+        lastAgentTicks += s.agentTicks;
+        for (int cell : s.touched) {
+            if (heatmap) heatmap->recordVisits(cell % w, cell / w, static_cast<int>(s.visits[cell]));
+            s.visits[cell] = 0;
+        }
+        s.touched.clear();
+    }
+
+    totalAgentTicks += lastAgentTicks;
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    if (secs > 0.0) lastAgentTicksPerSecond = lastAgentTicks / secs;
+}
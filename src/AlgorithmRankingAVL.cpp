@@ -8,15 +8,17 @@ float AlgorithmStats::calculateScore() const {
     // Premiar tesoros recolectados
 
     float score = 1000.0f;
+    float nodes = nodesDist.runs > 0 ? nodesDist.p50 : static_cast<float>(nodesExpanded);
+    float time = timeDist.runs > 0 ? timeDist.p50 : executionTime;
 
     // Penalizar expansión (0-500 puntos perdidos)
-    if (nodesExpanded > 0) {
-        score -= std::min(500.0f, nodesExpanded * 0.5f);
+    if (nodes > 0.0f) {
+        score -= std::min(500.0f, nodes * 0.5f);
     }
 
     // Penalizar tiempo (0-100 puntos perdidos)
-    if (executionTime > 0.0f) {
-        score -= std::min(100.0f, executionTime * 500.0f);
+    if (time > 0.0f) {
+        score -= std::min(100.0f, time * 500.0f);
     }
 
     // Bonus por tesoros (0-150 puntos)
@@ -29,39 +31,111 @@ std::string AlgorithmStats::getKey() const {
     return algorithmName;
 }
 
+void AlgorithmStatsAccumulator::add(const AlgorithmStats& run) {
+    time.add(run.executionTime);
+    nodes.add(run.nodesExpanded);
+    path.add(run.pathLength);
+    treasures.add(run.treasuresCollected);
+    search += run.search;
+}
+
+AlgorithmStats AlgorithmStatsAccumulator::summarize(const std::string& name) const {
+    AlgorithmStats s;
+    s.algorithmName = name;
+    s.timeDist = time.summarize();
+    s.nodesDist = nodes.summarize();
+    s.nodesExpanded = static_cast<int>(std::lround(nodes.getMoments().getMean()));
+    s.pathLength = static_cast<int>(std::lround(path.getMean()));
+    s.executionTime = static_cast<float>(time.getMoments().getMean());
+    s.treasuresCollected = static_cast<int>(std::lround(treasures.getMean()));
+    s.search = search.averaged(count());
+    return s;
+}
+
 
 AlgorithmRankingAVL::AlgorithmRankingAVL() 
-    : root(nullptr), nodeCount(0) {}
+    : used(0), root(NIL), nodeCount(0), epoch(1) {}
+
+AlgorithmRankingAVL::~AlgorithmRankingAVL() = default;
 
-AlgorithmRankingAVL::~AlgorithmRankingAVL() {
-    destroyTree(root);
+void AlgorithmRankingAVL::clear() {
+    // Sin destruir nada: los nodos y el payload se sobrescriben al reutilizarlos
+    // y el epoch invalida de golpe todo el índice nombre -> nodo
+    root = NIL;
+    used = 0;
+    nodeCount = 0;
+    freeSlots.clear();
+    if (++epoch == 0) {
+        std::fill(nameEpoch.begin(), nameEpoch.end(), 0);
+        epoch = 1;
+    }
 }
 
-void AlgorithmRankingAVL::destroyTree(AVLNode* node) {
-    if (!node) return;
-    destroyTree(node->left);
-    destroyTree(node->right);
-    delete node;
+size_t AlgorithmRankingAVL::bytesUsed() const {
+    size_t bytes = nodes.capacity() * sizeof(AVLNode)
+                 + payload.capacity() * sizeof(AlgorithmStats)
+                 + freeSlots.capacity() * sizeof(NodeId)
+                 + nodeOfName.capacity() * sizeof(NodeId)
+                 + nameEpoch.capacity() * sizeof(std::uint32_t);
+    for (const std::string& n : names) bytes += sizeof(std::string) + n.capacity();
+    return bytes;
 }
 
-void AlgorithmRankingAVL::clear() {
-    destroyTree(root);
-    root = nullptr;
-    nodeCount = 0;
+
+std::uint32_t AlgorithmRankingAVL::internName(const std::string& name) {
+    auto it = nameIds.find(name);
+    if (it != nameIds.end()) return it->second;
+    
+    std::uint32_t id = static_cast<std::uint32_t>(names.size());
+    names.push_back(name);
+    nameIds.emplace(name, id);
+    nodeOfName.push_back(NIL);
+    nameEpoch.push_back(0);
+    return id;
 }
 
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::lookup(const std::string& key) const {
+    auto it = nameIds.find(key);
+    if (it == nameIds.end() || nameEpoch[it->second] != epoch) return NIL;
+    return nodeOfName[it->second];
+}
 
-int AlgorithmRankingAVL::height(AVLNode* node) const {
-    return node ? node->height : 0;
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::allocNode(const AlgorithmStats& stats, std::uint32_t name) {
+    NodeId id;
+    if (!freeSlots.empty()) {
+        id = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        id = used++;
+        if (id == nodes.size()) {
+            nodes.emplace_back();
+            payload.emplace_back();
+        }
+    }
+    
+    nodes[id] = AVLNode{stats.calculateScore(), name, NIL, NIL, 1, 1};
+    payload[id] = stats;
+    return id;
 }
 
-int AlgorithmRankingAVL::getBalance(AVLNode* node) const {
-    return node ? height(node->left) - height(node->right) : 0;
+
+int AlgorithmRankingAVL::height(NodeId node) const {
+    return node != NIL ? nodes[node].height : 0;
 }
 
-void AlgorithmRankingAVL::updateHeight(AVLNode* node) {
-    if (node) {
-        node->height = 1 + std::max(height(node->left), height(node->right));
+int AlgorithmRankingAVL::subtreeSize(NodeId node) const {
+    return node != NIL ? nodes[node].count : 0;
+}
+
+int AlgorithmRankingAVL::getBalance(NodeId node) const {
+    return node != NIL ? height(nodes[node].left) - height(nodes[node].right) : 0;
+}
+
+void AlgorithmRankingAVL::updateHeight(NodeId node) {
+    if (node != NIL) {
+        AVLNode& n = nodes[node];
+        n.height = 1 + std::max(height(n.left), height(n.right));
+        n.count = 1 + subtreeSize(n.left) + subtreeSize(n.right);
     }
 }
 
@@ -74,14 +148,14 @@ int AlgorithmRankingAVL::getHeight() const {
 }
 
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateRight(AVLNode* y) {
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::rotateRight(NodeId y) {
 
-    AVLNode* x = y->left;
-    AVLNode* B = x->right;
+    NodeId x = nodes[y].left;
+    NodeId B = nodes[x].right;
     
     // Rotar
-    x->right = y;
-    y->left = B;
+    nodes[x].right = y;
+    nodes[y].left = B;
     
     // Actualizar alturas
     updateHeight(y);
@@ -90,14 +164,14 @@ AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateRight(AVLNode* y) {
     return x;
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateLeft(AVLNode* x) {
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::rotateLeft(NodeId x) {
 
-    AVLNode* y = x->right;
-    AVLNode* B = y->left;
+    NodeId y = nodes[x].right;
+    NodeId B = nodes[y].left;
     
     // Rotar
-    y->left = x;
-    x->right = B;
+    nodes[y].left = x;
+    nodes[x].right = B;
     
     // Actualizar alturas
     updateHeight(x);
@@ -106,42 +180,42 @@ AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateLeft(AVLNode* x) {
     return y;
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateLeftRight(AVLNode* node) {
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::rotateLeftRight(NodeId node) {
     
-    node->left = rotateLeft(node->left);
+    nodes[node].left = rotateLeft(nodes[node].left);
     return rotateRight(node);
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::rotateRightLeft(AVLNode* node) {
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::rotateRightLeft(NodeId node) {
 
-    node->right = rotateRight(node->right);
+    nodes[node].right = rotateRight(nodes[node].right);
     return rotateLeft(node);
 }
 
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::balance(AVLNode* node) {
-    if (!node) return nullptr;
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::balance(NodeId node) {
+    if (node == NIL) return NIL;
     
     updateHeight(node);
     int balanceFactor = getBalance(node);
     
     // Caso 1: Desbalance Izquierdo-Izquierdo (LL)
-    if (balanceFactor > 1 && getBalance(node->left) >= 0) {
+    if (balanceFactor > 1 && getBalance(nodes[node].left) >= 0) {
         return rotateRight(node);
     }
     
     // Caso 2: Desbalance Derecho-Derecho (RR)
-    if (balanceFactor < -1 && getBalance(node->right) <= 0) {
+    if (balanceFactor < -1 && getBalance(nodes[node].right) <= 0) {
         return rotateLeft(node);
     }
     
     // Caso 3: Desbalance Izquierdo-Derecho (LR)
-    if (balanceFactor > 1 && getBalance(node->left) < 0) {
+    if (balanceFactor > 1 && getBalance(nodes[node].left) < 0) {
         return rotateLeftRight(node);
     }
     
     // Caso 4: Desbalance Derecho-Izquierdo (RL)
-    if (balanceFactor < -1 && getBalance(node->right) > 0) {
+    if (balanceFactor < -1 && getBalance(nodes[node].right) > 0) {
         return rotateRightLeft(node);
     }
 
@@ -150,37 +224,41 @@ AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::balance(AVLNode* node) {
 }
 
 
-void AlgorithmRankingAVL::insert(const AlgorithmStats& stats) {
-    root = insertNode(root, stats);
+bool AlgorithmRankingAVL::ranksBefore(NodeId a, NodeId b) const {
+    const AVLNode& na = nodes[a];
+    const AVLNode& nb = nodes[b];
+    if (na.score != nb.score) return na.score > nb.score;  // Mayor score primero
+    if (na.name == nb.name) return false;
+    return names[na.name] < names[nb.name];  // Solo en empates se toca la tabla de nombres
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::insertNode(
-    AVLNode* node, 
-    const AlgorithmStats& stats
-) {
-    // Caso base: insertar aquí
-    if (!node) {
-        nodeCount++;
-        return new AVLNode(stats);
+void AlgorithmRankingAVL::insert(const AlgorithmStats& stats) {
+    std::uint32_t name = internName(stats.getKey());
+    
+    // Si existe, actualizar: desenganchar el viejo y reinsertar en su nueva posición
+    if (nameEpoch[name] == epoch) {
+        NodeId old = nodeOfName[name];
+        root = detachNode(root, old);
+        freeSlots.push_back(old);
+        nodeCount--;
     }
     
-    // Ordenar por score (DESCENDENTE: mayor score = mejor)
-    // Pero si existe, actualizar
-    std::string key = stats.getKey();
-    std::string nodeKey = node->data.getKey();
-    
-    if (key == nodeKey) {
-        // Actualizar nodo existente
-        node->data = stats;
-        node->score = stats.calculateScore();
-        return node;
-    }
+    NodeId fresh = allocNode(stats, name);
+    root = insertNode(root, fresh);
+    nodeOfName[name] = fresh;
+    nameEpoch[name] = epoch;
+    nodeCount++;
+}
+
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::insertNode(NodeId node, NodeId fresh) {
+    // Caso base: insertar aquí
+    if (node == NIL) return fresh;
     
-    // Comparar por score (mayor a la izquierda)
-    if (stats.calculateScore() > node->score) {
-        node->left = insertNode(node->left, stats);
+    // Mejor ranking a la izquierda
+    if (ranksBefore(fresh, node)) {
+        nodes[node].left = insertNode(nodes[node].left, fresh);
     } else {
-        node->right = insertNode(node->right, stats);
+        nodes[node].right = insertNode(nodes[node].right, fresh);
     }
     
     // Balancear después de inserción
@@ -189,140 +267,164 @@ AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::insertNode(
 
 
 bool AlgorithmRankingAVL::find(const std::string& key, AlgorithmStats& out) const {
-    AVLNode* result = findNode(root, key);
-    if (result) {
-        out = result->data;
-        return true;
-    }
-    return false;
-}
-
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::findNode(
-    AVLNode* node, 
-    const std::string& key
-) const {
-    if (!node) return nullptr;
-    
-    std::string nodeKey = node->data.getKey();
-    
-    if (key == nodeKey) {
-        return node;
-    }
-    
-    // Buscar en ambos subárboles (no sabemos si está por score)
-    AVLNode* leftResult = findNode(node->left, key);
-    if (leftResult) return leftResult;
-    
-    return findNode(node->right, key);
+    NodeId node = lookup(key);
+    if (node == NIL) return false;
+    out = payload[node];
+    return true;
 }
 
 
 void AlgorithmRankingAVL::update(const std::string& key, const AlgorithmStats& newStats) {
-    // Buscar y eliminar viejo
-    root = deleteNode(root, key);
+    // Buscar y eliminar viejo (camino dirigido por score+nombre: O(log n))
+    remove(key);
     
     // Insertar nuevo
     insert(newStats);
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::deleteNode(
-    AVLNode* node, 
-    const std::string& key
-) {
-    if (!node) return nullptr;
+bool AlgorithmRankingAVL::remove(const std::string& key) {
+    NodeId target = lookup(key);
+    if (target == NIL) return false;
     
-    std::string nodeKey = node->data.getKey();
+    nameEpoch[nodes[target].name] = 0;
+    root = detachNode(root, target);
+    freeSlots.push_back(target);
+    nodeCount--;
+    return true;
+}
+
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::detachNode(NodeId node, NodeId target) {
+    if (node == NIL) return NIL;
     
-    if (key == nodeKey) {
-        // Caso 1: Nodo hoja
-        if (!node->left && !node->right) {
-            delete node;
-            nodeCount--;
-            return nullptr;
-        }
+    if (node == target) {
+        // Caso 1 y 2: Nodo hoja o un hijo
+        if (nodes[node].left == NIL) return nodes[node].right;
+        if (nodes[node].right == NIL) return nodes[node].left;
         
-        // Caso 2: Un hijo
-        if (!node->left) {
-            AVLNode* temp = node->right;
-            delete node;
-            nodeCount--;
-            return temp;
-        }
-        if (!node->right) {
-            AVLNode* temp = node->left;
-            delete node;
-            nodeCount--;
-            return temp;
-        }
-        
-        // Caso 3: Dos hijos - reemplazar con sucesor
-        AVLNode* successor = findMin(node->right);
-        node->data = successor->data;
-        node->score = successor->score;
-        node->right = deleteNode(node->right, successor->data.getKey());
+        // Caso 3: Dos hijos - el sucesor ocupa el lugar del nodo
+        // (se re-enlaza en vez de copiar datos: el índice no cambia)
+        NodeId successor = NIL;
+        NodeId rest = detachMin(nodes[node].right, successor);
+        nodes[successor].left = nodes[node].left;
+        nodes[successor].right = rest;
+        return balance(successor);
+    }
+    
+    if (ranksBefore(target, node)) {
+        nodes[node].left = detachNode(nodes[node].left, target);
     } else {
-        // Buscar en ambos subárboles
-        node->left = deleteNode(node->left, key);
-        node->right = deleteNode(node->right, key);
+        nodes[node].right = detachNode(nodes[node].right, target);
     }
     
     return balance(node);
 }
 
-AlgorithmRankingAVL::AVLNode* AlgorithmRankingAVL::findMin(AVLNode* node) const {
-    while (node && node->left) {
-        node = node->left;
+AlgorithmRankingAVL::NodeId AlgorithmRankingAVL::detachMin(NodeId node, NodeId& minOut) {
+    if (nodes[node].left == NIL) {
+        minOut = node;
+        return nodes[node].right;
     }
-    return node;
+    nodes[node].left = detachMin(nodes[node].left, minOut);
+    return balance(node);
 }
 
-void AlgorithmRankingAVL::inorderTraversal(AVLNode* node, std::vector<AVLNode*>& result) const {
-    if (!node) return;
-    
-    // Inorder: izquierda -> raíz -> derecha
-    // Como insertamos mayor a la izquierda, esto da orden DESCENDENTE
-    inorderTraversal(node->left, result);
-    result.push_back(node);
-    inorderTraversal(node->right, result);
+std::vector<RankEntry> AlgorithmRankingAVL::getTopK(int k) const {
+    return getRange(1, k);
 }
 
-std::vector<RankEntry> AlgorithmRankingAVL::getTopK(int k) const {
-    std::vector<AVLNode*> allNodes;
-    inorderTraversal(root, allNodes);
-    
+std::vector<RankEntry> AlgorithmRankingAVL::getAll() const {
+    return getRange(1, nodeCount);
+}
+
+std::vector<RankEntry> AlgorithmRankingAVL::getRange(int firstRank, int count) const {
     std::vector<RankEntry> rankings;
-    rankings.reserve(std::min(k, static_cast<int>(allNodes.size())));
+    if (firstRank < 1 || firstRank > nodeCount || count <= 0) return rankings;
+    
+    int last = std::min(nodeCount, firstRank + count - 1);
+    rankings.reserve(last - firstRank + 1);
+    
+    // Bajar hasta el nodo 'firstRank' apilando los ancestros que quedan
+    // después de él en el recorrido inorder (los que dejamos por la izquierda)
+    std::vector<NodeId> pending;
+    pending.reserve(height(root));
+    NodeId node = root;
+    int r = firstRank;
+    while (node != NIL) {
+        int leftSize = subtreeSize(nodes[node].left);
+        if (r <= leftSize) {
+            pending.push_back(node);
+            node = nodes[node].left;
+        } else if (r == leftSize + 1) {
+            pending.push_back(node);
+            break;
+        } else {
+            r -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
     
-    for (int i = 0; i < std::min(k, static_cast<int>(allNodes.size())); ++i) {
-        rankings.emplace_back(allNodes[i]->data, i + 1);
+    // Inorder iterativo desde ahí: solo se visitan las entradas pedidas
+    for (int rank = firstRank; rank <= last && !pending.empty(); ++rank) {
+        NodeId cur = pending.back();
+        pending.pop_back();
+        rankings.emplace_back(payload[cur], rank);
+        
+        for (NodeId n = nodes[cur].right; n != NIL; n = nodes[n].left) {
+            pending.push_back(n);
+        }
     }
     
     return rankings;
 }
 
-std::vector<RankEntry> AlgorithmRankingAVL::getAll() const {
-    std::vector<AVLNode*> allNodes;
-    inorderTraversal(root, allNodes);
-    
-    std::vector<RankEntry> rankings;
-    rankings.reserve(allNodes.size());
+int AlgorithmRankingAVL::rankOf(const std::string& key) const {
+    NodeId target = lookup(key);
+    if (target == NIL) return 0;
     
-    for (size_t i = 0; i < allNodes.size(); ++i) {
-        rankings.emplace_back(allNodes[i]->data, static_cast<int>(i) + 1);
+    int rank = 0;
+    NodeId node = root;
+    while (node != NIL) {
+        if (node == target) {
+            return rank + subtreeSize(nodes[node].left) + 1;
+        }
+        if (ranksBefore(target, node)) {
+            node = nodes[node].left;
+        } else {
+            rank += subtreeSize(nodes[node].left) + 1;
+            node = nodes[node].right;
+        }
     }
-    
-    return rankings;
+    return 0;
+}
+
+bool AlgorithmRankingAVL::select(int rank, AlgorithmStats& out) const {
+    if (rank < 1 || rank > nodeCount) return false;
+    
+    NodeId node = root;
+    while (node != NIL) {
+        int leftSize = subtreeSize(nodes[node].left);
+        if (rank <= leftSize) {
+            node = nodes[node].left;
+        } else if (rank == leftSize + 1) {
+            out = payload[node];
+            return true;
+        } else {
+            rank -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+    return false;
 }
 
 bool AlgorithmRankingAVL::isBalanced() const {
     return isBalancedHelper(root);
 }
 
-bool AlgorithmRankingAVL::isBalancedHelper(AVLNode* node) const {
-    if (!node) return true;
+bool AlgorithmRankingAVL::isBalancedHelper(NodeId node) const {
+    if (node == NIL) return true;
     
     int balance = getBalance(node);
     if (std::abs(balance) > 1) return false;
     
-    return isBalancedHelper(node->left) && isBalancedHelper(node->right);
-}
\ No newline at end of file
+    return isBalancedHelper(nodes[node].left) && isBalancedHelper(nodes[node].right);
+}
@@ -0,0 +1,167 @@
+#include "BatchQuerySolver.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+BatchQuerySolver::BatchQuerySolver(const Grid& grid, int threads)
+    : g(grid), threadCount(threads) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+    scratch.resize(threadCount);
+}
+
+void BatchQuerySolver::prepareScratch(Scratch& s) {
+    size_t cells = static_cast<size_t>(g.width()) * g.height();
+    if (s.seen.size() == cells) return;
+
+    s.seen.assign(cells, 0);
+    s.target.assign(cells, 0);
+    s.dist.assign(cells, 0);
+    s.parent.assign(cells, -1);
+    s.queue.assign(cells, 0);
+    s.epoch = 0;
+}
+
+std::vector<QueryResult> BatchQuerySolver::solve(const std::vector<PathQuery>& queries, bool wantPaths) {
+    std::vector<QueryResult> results(queries.size());
+    lastStats = SearchStats();
+    if (queries.empty()) return results;
+
+    // Agrupar por origen (orden de primera aparición)
+    std::unordered_map<int, int> groupOf;
+    std::vector<int> groupSource;
+    std::vector<std::vector<int>> groups;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const Coord& start = queries[i].start;
+        if (start.x < 0 || start.y < 0 || start.x >= g.width() || start.y >= g.height()) continue;
+
+        int sourceId = start.y * g.width() + start.x;
+        auto it = groupOf.find(sourceId);
+        if (it == groupOf.end()) {
+            it = groupOf.emplace(sourceId, static_cast<int>(groups.size())).first;
+            groupSource.push_back(sourceId);
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(static_cast<int>(i));
+    }
+
+    // Cada hilo toma el siguiente grupo libre; los resultados van a índices
+    // distintos, así que no hace falta sincronizar la escritura
+    std::atomic<size_t> nextGroup(0);
+    auto worker = [&](int t) {
+        Scratch& s = scratch[t];
+        s.stats = SearchStats();
+        {
+            PhaseTimer initTimer(s.stats.initTime);
+            prepareScratch(s);
+        }
+        for (size_t gi = nextGroup++; gi < groups.size(); gi = nextGroup++) {
+            solveGroup(s, groupSource[gi], groups[gi], queries, results, wantPaths);
+        }
+    };
+
+    int workers = std::max(1, std::min(threadCount, static_cast<int>(groups.size())));
+    if (workers == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int t = 0; t < workers; ++t) threads.emplace_back(worker, t);
+        for (auto& th : threads) th.join();
+    }
+
+    // Juntar contadores por hilo
+    for (int t = 0; t < workers; ++t) {
+        lastStats += scratch[t].stats;
+        lastStats.bytesAllocated += scratch[t].seen.size() * (2 * sizeof(std::uint32_t) + 3 * sizeof(int));
+    }
+    return results;
+}
+
+void BatchQuerySolver::solveGroup(Scratch& s, int sourceId, const std::vector<int>& queryIdx,
+                                  const std::vector<PathQuery>& queries,
+                                  std::vector<QueryResult>& results, bool wantPaths) {
+    const int W = g.width();
+    const int H = g.height();
+
+    // Nuevo epoch: invalida seen/target sin recorrer los arreglos
+    if (++s.epoch == 0) {
+        std::fill(s.seen.begin(), s.seen.end(), 0);
+        std::fill(s.target.begin(), s.target.end(), 0);
+        s.epoch = 1;
+    }
+    const std::uint32_t epoch = s.epoch;
+
+    int pendingTargets = 0;
+    for (int qi : queryIdx) {
+        const Coord& goal = queries[qi].goal;
+        if (goal.x < 0 || goal.y < 0 || goal.x >= W || goal.y >= H) continue;
+        int goalId = goal.y * W + goal.x;
+        if (s.target[goalId] != epoch) {
+            s.target[goalId] = epoch;
+            pendingTargets++;
+        }
+    }
+
+    // BFS desde el origen (todas las aristas cuestan 1)
+    PhaseTimer searchTimer(s.stats.searchTime);
+    int head = 0, tail = 0;
+    s.queue[tail++] = sourceId;
+    s.seen[sourceId] = epoch;
+    s.dist[sourceId] = 0;
+    s.parent[sourceId] = -1;
+    if (s.target[sourceId] == epoch) pendingTargets--;
+
+    const int dx[4] = {0, -1, 1, 0};
+    const int dy[4] = {-1, 0, 0, 1};
+
+    while (head < tail && pendingTargets > 0) {
+        int cur = s.queue[head++];
+        s.stats.pops++;
+        int cx = cur % W, cy = cur / W;
+        const Cell& cell = g.at(cx, cy);
+
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.walls[dir]) continue;
+            int nx = cx + dx[dir], ny = cy + dy[dir];
+            if (nx < 0 || ny < 0 || nx >= W || ny >= H) continue;
+
+            int nid = ny * W + nx;
+            if (s.seen[nid] == epoch) continue;
+            s.seen[nid] = epoch;
+            s.dist[nid] = s.dist[cur] + 1;
+            s.parent[nid] = cur;
+            s.queue[tail++] = nid;
+            s.stats.notePush(tail - head);
+
+            if (s.target[nid] == epoch) pendingTargets--;
+        }
+    }
+
+    s.stats.pushes++;  // origen
+    searchTimer.stop();
+
+    // Leer respuestas del árbol BFS
+    PhaseTimer pathTimer(s.stats.reconstructTime);
+    for (int qi : queryIdx) {
+        const Coord& goal = queries[qi].goal;
+        QueryResult& out = results[qi];
+        if (goal.x < 0 || goal.y < 0 || goal.x >= W || goal.y >= H) continue;
+
+        int goalId = goal.y * W + goal.x;
+        if (s.seen[goalId] != epoch) continue;
+
+        out.distance = s.dist[goalId];
+        if (wantPaths) {
+            out.path.resize(out.distance + 1);
+            int cur = goalId;
+            for (int k = out.distance; k >= 0; --k) {
+                out.path[k] = Coord(cur % W, cur / W);
+                cur = s.parent[cur];
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "BenchmarkRunner.h"
+#include "ChallengeSystem.h"
+#include "CollectorSolver.h"
+#include "Grid.h"
+
+#include "CollectorMazeGen.cpp"
+
+#include <chrono>
+#include <random>
+
+const std::vector<std::string>& benchmarkGenerators() {
+    static const std::vector<std::string> generators = {"DFS", "Prim's", "Hunt&Kill", "Kruskal's"};
+    return generators;
+}
+
+const std::vector<std::pair<SolverStrategy, std::string>>& benchmarkSolvers() {
+    static const std::vector<std::pair<SolverStrategy, std::string>> solvers = {
+        {SolverStrategy::ASTAR, "A*"},
+        {SolverStrategy::GREEDY, "Greedy"},
+        {SolverStrategy::UCS, "UCS"},
+        {SolverStrategy::DFS, "DFS"},
+        {SolverStrategy::DEADEND_FILL, "Dead-End Fill"}  // Línea base sin búsqueda
+    };
+    return solvers;
+}
+
+// Crear el generador (modo coleccionista) por nombre
+std::unique_ptr<MazeAlgorithm> makeCollectorGenerator(const std::string& genAlgo, Grid& grid,
+                                                      ChallengeSystem* challenges, unsigned seed) {
+    std::unique_ptr<MazeAlgorithm> algo;
+    if (genAlgo == "Prim's") {
+        algo.reset(new PrimsCollectorAlgorithm(grid, challenges, seed));
+    } else if (genAlgo == "Hunt&Kill") {
+        algo.reset(new HuntAndKillCollectorAlgorithm(grid, challenges, seed));
+    } else if (genAlgo == "Kruskal's") {
+        algo.reset(new KruskalsCollectorAlgorithm(grid, challenges, seed));
+    } else {
+        algo.reset(new DFSCollectorAlgorithm(grid, challenges, seed));
+    }
+    return algo;
+}
+
+PreparedMaze prepareBenchmarkMaze(const std::string& genAlgo, int gridW, int gridH, unsigned seed) {
+    PreparedMaze maze;
+    maze.generator = genAlgo;
+    maze.seed = seed;
+    maze.grid = std::make_unique<Grid>(gridW, gridH);
+    maze.challenges = std::make_unique<ChallengeSystem>(*maze.grid);
+
+    // Generar laberinto (sin visualización, sin contar tiempo)
+    std::unique_ptr<MazeAlgorithm> algo = makeCollectorGenerator(genAlgo, *maze.grid, maze.challenges.get(), seed);
+    algo->runToEnd();
+
+    // Meta elegida con el mismo seed: laberinto reproducible completo
+    std::srand(seed);
+    maze.start = Coord(gridW / 2, gridH / 2);
+    maze.goal = getRandomCorner(*maze.grid, maze.start);
+    return maze;
+}
+
+AlgorithmStats solvePreparedMaze(const PreparedMaze& maze, SolverStrategy strategy,
+                                 const std::string& solverName,
+                                 HeatmapAggregator::Shard* heatShard) {
+    AlgorithmStats stats;
+    stats.algorithmName = solverName;
+
+    // Copia propia de los tesoros: el solver los recolecta
+    ChallengeSystem challenges(*maze.challenges);
+
+    // El constructor (estado, heatmap, orden de objetivos) va a search.initTime;
+    // executionTime mide SOLO la resolución
+    CollectorSolver solver(*maze.grid, challenges, maze.start, maze.goal, strategy);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    while (!solver.finished()) {
+        solver.step();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> duration = endTime - startTime;
+
+    // Recopilar estadísticas REALES
+    stats.nodesExpanded = solver.getNodesExpanded();  // Contador real
+    stats.pathLength = static_cast<int>(solver.getFullPath().size());
+    stats.executionTime = duration.count();
+    stats.treasuresCollected = solver.getTreasuresCollected();
+    stats.search = solver.getSearchStats();
+
+    if (heatShard) heatShard->add(solver.getHeatmap());
+
+    return stats;
+}
+
+// Ejecutar UN benchmark: un solver en un laberinto generado
+// heatShard (opcional): acumula el heatmap de exploración de la corrida
+AlgorithmStats runSingleBenchmark(const std::string& genAlgo, SolverStrategy strategy,
+                                  const std::string& solverName, int gridW, int gridH,
+                                  HeatmapAggregator::Shard* heatShard) {
+    PreparedMaze maze = prepareBenchmarkMaze(genAlgo, gridW, gridH, std::random_device{}());
+    return solvePreparedMaze(maze, strategy, solverName, heatShard);
+}
@@ -0,0 +1,67 @@
+#include "BenchmarkScheduler.h"
+#include <chrono>
+#include <cstdint>
+
+BenchmarkScheduler::BenchmarkScheduler(BenchmarkConfig cfg)
+    : config(std::move(cfg)), pool(config.threadCount) {}
+
+unsigned BenchmarkScheduler::mazeSeed(int generator, int iteration) const {
+    // Mezcla tipo splitmix: seeds vecinos no dan laberintos parecidos
+    std::uint64_t x = (static_cast<std::uint64_t>(config.baseSeed) << 32) ^
+                      (static_cast<std::uint64_t>(generator) << 20) ^ static_cast<std::uint64_t>(iteration);
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<unsigned>(x);
+}
+
+std::vector<BenchmarkResult> BenchmarkScheduler::run(std::vector<HeatmapAggregator>* heatmaps) {
+    using Clock = std::chrono::steady_clock;
+
+    const int genCount = static_cast<int>(config.generators.size());
+    const int solverCount = static_cast<int>(config.solvers.size());
+    const int iterations = config.iterations > 0 ? config.iterations : 0;
+
+    lastGenerateSeconds = 0.0;
+    lastSolveSeconds = 0.0;
+    if (genCount == 0 || solverCount == 0 || iterations == 0) return {};
+
+    if (heatmaps) {
+        bool usable = static_cast<int>(heatmaps->size()) >= solverCount;
+        for (size_t s = 0; usable && s < heatmaps->size(); ++s) {
+            usable = (*heatmaps)[s].getShardCount() >= getThreadCount();
+        }
+        if (!usable) heatmaps = nullptr;  // Sin shards suficientes no hay escritura segura
+    }
+
+    // Fase 1: generar en serie (std::rand no es seguro entre hilos)
+    auto genStart = Clock::now();
+    std::vector<PreparedMaze> mazes;
+    mazes.reserve(static_cast<size_t>(genCount) * iterations);
+    for (int g = 0; g < genCount; ++g) {
+        for (int i = 0; i < iterations; ++i) {
+            mazes.push_back(prepareBenchmarkMaze(config.generators[g], config.width, config.height, mazeSeed(g, i)));
+        }
+    }
+    lastGenerateSeconds = std::chrono::duration<double>(Clock::now() - genStart).count();
+
+    // Fase 2: resolver en paralelo; tarea t = laberinto t / solverCount, solver t % solverCount
+    std::vector<BenchmarkResult> results(mazes.size() * solverCount);
+    auto solveStart = Clock::now();
+    pool.run(results.size(), [&](size_t t, int worker) {
+        size_t mazeIndex = t / solverCount;
+        int s = static_cast<int>(t % solverCount);
+
+        BenchmarkResult& r = results[t];
+        r.generator = static_cast<int>(mazeIndex / iterations);
+        r.iteration = static_cast<int>(mazeIndex % iterations);
+        r.solver = s;
+
+        HeatmapAggregator::Shard* shard = heatmaps ? &(*heatmaps)[s].shard(worker) : nullptr;
+        r.stats = solvePreparedMaze(mazes[mazeIndex], config.solvers[s].first, config.solvers[s].second, shard);
+    });
+    lastSolveSeconds = std::chrono::duration<double>(Clock::now() - solveStart).count();
+
+    return results;
+}
@@ -1,9 +1,37 @@
 #include "ChallengeSystem.h"
 #include <algorithm>
+#include <cstdlib>
 
-ChallengeSystem::ChallengeSystem(Grid& grid) : g(grid) {}
+ChallengeSystem::ChallengeSystem(Grid& grid)
+    : g(grid), width(grid.width()), height(grid.height()),
+      bucketsX((grid.width() + BUCKET_SIZE - 1) / BUCKET_SIZE),
+      bucketsY((grid.height() + BUCKET_SIZE - 1) / BUCKET_SIZE) {
+    size_t cells = static_cast<size_t>(width) * height;
+    treasureBits = std::vector<std::atomic<std::uint64_t>>((cells + 63) / 64);
+    for (auto& word : treasureBits) word.store(0, std::memory_order_relaxed);
+    placedBits.assign((cells + 63) / 64, 0);
+    buckets.resize(static_cast<size_t>(bucketsX) * bucketsY);
+    slotInBucket.assign(cells, -1);
+}
+
+ChallengeSystem::ChallengeSystem(const ChallengeSystem& other)
+    : g(other.g), width(other.width), height(other.height),
+      bucketsX(other.bucketsX), bucketsY(other.bucketsY),
+      collectedCount(other.collectedCount.load(std::memory_order_acquire)),
+      concurrentMode(other.concurrentMode),
+      treasureBits(other.treasureBits.size()),
+      placedBits(other.placedBits),
+      buckets(other.buckets),
+      slotInBucket(other.slotInBucket),
+      treasurePositions(other.treasurePositions) {
+    for (size_t i = 0; i < treasureBits.size(); ++i) {
+        treasureBits[i].store(other.treasureBits[i].load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
 
 void ChallengeSystem::placeTreasureAt(const Coord& pos) {
+    if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height) return;
+
     // No colocar en inicio (centro)
     int centerX = g.width() / 2;
     int centerY = g.height() / 2;
@@ -14,45 +42,178 @@ void ChallengeSystem::placeTreasureAt(const Coord& pos) {
         (pos.y == 0 || pos.y == g.height() - 1)) return;
     
     // No duplicar
-    if (elements.find(pos) != elements.end()) return;
+    size_t id = cellId(pos);
+    std::uint64_t bit = std::uint64_t(1) << (id & 63);
+    if (placedBits[id >> 6] & bit) return;
     
-    elements[pos] = SpecialElement::TREASURE;
+    placedBits[id >> 6] |= bit;
+    treasureBits[id >> 6].fetch_or(bit, std::memory_order_relaxed);
+    std::vector<std::uint32_t>& bucket = buckets[bucketOf(pos.x, pos.y)];
+    slotInBucket[id] = static_cast<std::int32_t>(bucket.size());
+    bucket.push_back(static_cast<std::uint32_t>(id));
     treasurePositions.push_back(pos);
 }
 
-bool ChallengeSystem::hasTreasure(const Coord& pos) const {
-
-    auto it = elements.find(pos);
-    return (it != elements.end() && it->second == SpecialElement::TREASURE);
-}
-
 bool ChallengeSystem::collectTreasure(const Coord& pos) {
-    auto it = elements.find(pos);
+    if (!hasTreasure(pos)) {
+        return false;
+    }
     
-    if (it == elements.end() || it->second != SpecialElement::TREASURE) {
+    // Reclamar: apagar el bit de forma atómica; gana solo quien lo vio encendido
+    size_t id = cellId(pos);
+    std::uint64_t bit = std::uint64_t(1) << (id & 63);
+    if (!(treasureBits[id >> 6].fetch_and(~bit, std::memory_order_acq_rel) & bit)) {
         return false;
     }
+    collectedCount.fetch_add(1, std::memory_order_acq_rel);
     
-    // Marcar como recolectado (cambiar a NONE)
-    it->second = SpecialElement::NONE;
-    collectedCount++;
+    // En modo concurrente las cubetas quedan intactas hasta compactBuckets()
+    if (concurrentMode) return true;
+    
+    // Quitar de la cubeta: mover el último al hueco
+    std::vector<std::uint32_t>& bucket = buckets[bucketOf(pos.x, pos.y)];
+    std::int32_t slot = slotInBucket[id];
+    std::uint32_t moved = bucket.back();
+    bucket[slot] = moved;
+    slotInBucket[moved] = slot;
+    bucket.pop_back();
+    slotInBucket[id] = -1;
     return true;
 }
 
+void ChallengeSystem::setConcurrentMode(bool enabled) {
+    if (concurrentMode && !enabled) compactBuckets();
+    concurrentMode = enabled;
+}
+
+void ChallengeSystem::compactBuckets() {
+    for (auto& bucket : buckets) {
+        size_t kept = 0;
+        for (std::uint32_t id : bucket) {
+            if (isRemaining(id)) {
+                slotInBucket[id] = static_cast<std::int32_t>(kept);
+                bucket[kept++] = id;
+            } else {
+                slotInBucket[id] = -1;
+            }
+        }
+        bucket.resize(kept);
+    }
+}
+
+std::vector<Coord> ChallengeSystem::snapshotRemaining() const {
+    std::vector<Coord> remaining;
+    remaining.reserve(std::max(0, remainingTreasures()));
+    for (size_t w = 0; w < treasureBits.size(); ++w) {
+        std::uint64_t word = treasureBits[w].load(std::memory_order_acquire);
+        while (word) {
+            int b = 0;
+            while (!((word >> b) & 1u)) ++b;
+            word &= word - 1;
+            size_t id = w * 64 + b;
+            remaining.push_back(Coord(static_cast<int>(id % width), static_cast<int>(id / width)));
+        }
+    }
+    return remaining;
+}
+
 const std::vector<Coord>& ChallengeSystem::getTreasurePositions() const {
     return treasurePositions;
 }
 
 bool ChallengeSystem::allTreasuresCollected() const {
-    return collectedCount == static_cast<int>(treasurePositions.size());
+    return getCollectedCount() == static_cast<int>(treasurePositions.size());
 }
 
 int ChallengeSystem::remainingTreasures() const {
-    return static_cast<int>(treasurePositions.size()) - collectedCount;
+    return static_cast<int>(treasurePositions.size()) - getCollectedCount();
+}
+
+int ChallengeSystem::distanceToBucket(const Coord& p, int bx, int by) const {
+    int x0 = bx * BUCKET_SIZE, x1 = std::min(width, x0 + BUCKET_SIZE) - 1;
+    int y0 = by * BUCKET_SIZE, y1 = std::min(height, y0 + BUCKET_SIZE) - 1;
+    int dx = p.x < x0 ? x0 - p.x : (p.x > x1 ? p.x - x1 : 0);
+    int dy = p.y < y0 ? y0 - p.y : (p.y > y1 ? p.y - y1 : 0);
+    return dx + dy;
+}
+
+std::optional<Coord> ChallengeSystem::nearestTreasure(const Coord& from) const {
+    return nearestTreasure(from, nullptr);
+}
+
+std::optional<Coord> ChallengeSystem::nearestTreasure(const Coord& from,
+                                                      const std::function<bool(const Coord&)>& accept) const {
+    if (remainingTreasures() <= 0) return std::nullopt;
+
+    const int cbx = std::clamp(from.x, 0, width - 1) / BUCKET_SIZE;
+    const int cby = std::clamp(from.y, 0, height - 1) / BUCKET_SIZE;
+    const int maxRing = std::max({cbx, bucketsX - 1 - cbx, cby, bucketsY - 1 - cby});
+
+    int bestDist = -1;
+    std::uint32_t bestId = 0;
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // Toda cubeta del anillo r está al menos a (r-1)*BUCKET_SIZE+1 celdas
+        if (bestDist >= 0 && ring > 0 && (ring - 1) * BUCKET_SIZE + 1 > bestDist) break;
+
+        for (int by = cby - ring; by <= cby + ring; ++by) {
+            if (by < 0 || by >= bucketsY) continue;
+            // Solo el borde del anillo (filas extremas completas, columnas extremas en el medio)
+            bool edgeRow = (by == cby - ring || by == cby + ring);
+            int step = edgeRow ? 1 : std::max(1, 2 * ring);
+            for (int bx = cbx - ring; bx <= cbx + ring; bx += step) {
+                if (bx < 0 || bx >= bucketsX) continue;
+                const std::vector<std::uint32_t>& bucket = buckets[by * bucketsX + bx];
+                if (bucket.empty()) continue;
+                if (bestDist >= 0 && distanceToBucket(from, bx, by) >= bestDist) continue;
+
+                for (std::uint32_t id : bucket) {
+                    if (concurrentMode && !isRemaining(id)) continue;
+                    int tx = static_cast<int>(id % width), ty = static_cast<int>(id / width);
+                    if (accept && !accept(Coord(tx, ty))) continue;
+                    int d = std::abs(tx - from.x) + std::abs(ty - from.y);
+                    if (bestDist < 0 || d < bestDist || (d == bestDist && id < bestId)) {
+                        bestDist = d;
+                        bestId = id;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestDist < 0) return std::nullopt;
+    return Coord(static_cast<int>(bestId % width), static_cast<int>(bestId / width));
+}
+
+std::vector<Coord> ChallengeSystem::treasuresWithinRadius(const Coord& center, int radius) const {
+    std::vector<Coord> found;
+    if (radius < 0) return found;
+
+    int bx0 = std::max(0, (center.x - radius) / BUCKET_SIZE);
+    int bx1 = std::min(bucketsX - 1, (center.x + radius) / BUCKET_SIZE);
+    int by0 = std::max(0, (center.y - radius) / BUCKET_SIZE);
+    int by1 = std::min(bucketsY - 1, (center.y + radius) / BUCKET_SIZE);
+
+    for (int by = by0; by <= by1; ++by) {
+        for (int bx = bx0; bx <= bx1; ++bx) {
+            if (distanceToBucket(center, bx, by) > radius) continue;
+            for (std::uint32_t id : buckets[by * bucketsX + bx]) {
+                if (concurrentMode && !isRemaining(id)) continue;
+                int tx = static_cast<int>(id % width), ty = static_cast<int>(id / width);
+                if (std::abs(tx - center.x) + std::abs(ty - center.y) <= radius) {
+                    found.push_back(Coord(tx, ty));
+                }
+            }
+        }
+    }
+    return found;
 }
 
 void ChallengeSystem::clear() {
-    elements.clear();
+    for (auto& word : treasureBits) word.store(0, std::memory_order_relaxed);
+    std::fill(placedBits.begin(), placedBits.end(), 0);
+    for (auto& bucket : buckets) bucket.clear();
+    std::fill(slotInBucket.begin(), slotInBucket.end(), -1);
     treasurePositions.clear();
-    collectedCount = 0;
-}
\ No newline at end of file
+    collectedCount.store(0, std::memory_order_release);
+}
@@ -2,7 +2,7 @@
 // - Empiezan desde centro
 // - Colocan tesoros al 33%, 66%, 90% de progreso
 
-#include "MazeAlgorithm.h"
+#include "CoroutineMazeAlgorithm.h"
 #include "ChallengeSystem.h"
 #include <stack>
 #include <vector>
@@ -11,7 +11,8 @@
 #include <cstdlib>
 #include <ctime>
 
-Coord getRandomCorner(const Grid& g, const Coord& avoid) {
+// inline: este archivo se incluye desde main.cpp y BenchmarkRunner.cpp
+inline Coord getRandomCorner(const Grid& g, const Coord& avoid) {
     std::vector<Coord> corners = {
         Coord(0, 0),
         Coord(g.width() - 1, 0),
@@ -31,113 +32,97 @@ Coord getRandomCorner(const Grid& g, const Coord& avoid) {
     return valid[std::rand() % valid.size()];
 }
 
-struct DFSCollectorAlgorithm : public MazeAlgorithm {
-    Grid &g;
+// Tesoros al 33%, 66% y 90% del progreso; a lo sumo uno por evento, en la
+// celda de ese evento
+struct TreasureSchedule {
     ChallengeSystem *challenges;
-    std::stack<Coord> path;
-    bool done = false;
-    int visitedCount = 0;
     int totalCells;
-    bool treasure1Placed = false;
-    bool treasure2Placed = false;
-    bool treasure3Placed = false;
-    
-    DFSCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr) 
-        : g(grid), challenges(cs), totalCells(grid.width() * grid.height()) {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        
+    int placed = 0;
+
+    TreasureSchedule(ChallengeSystem *cs, const Grid &g)
+        : challenges(cs), totalCells(g.width() * g.height()) {}
+
+    void update(int visitedCount, const Coord &at) {
+        static constexpr float thresholds[3] = {0.33f, 0.66f, 0.90f};
+        if (!challenges || placed == 3) return;
+        if (static_cast<float>(visitedCount) / totalCells >= thresholds[placed]) {
+            challenges->placeTreasureAt(at);
+            placed++;
+        }
+    }
+};
+
+struct DFSCollectorAlgorithm : public CoroutineMazeAlgorithm {
+    DFSCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr,
+                          unsigned seed = static_cast<unsigned>(std::time(nullptr)))
+        : CoroutineMazeAlgorithm(generate(grid, cs, seed)) {}
+
+    static Generator<Coord> generate(Grid &g, ChallengeSystem *cs, unsigned seed) {
+        std::srand(seed);
+        TreasureSchedule treasures(cs, g);
+
         // Empezar desde centro
+        std::stack<Coord> path;
         Coord start(g.width() / 2, g.height() / 2);
         path.push(start);
         g.at(start.x, start.y).visited = true;
-        visitedCount = 1;
-    }
+        int visitedCount = 1;
+        co_yield start;
 
-    bool step() override {
-        if (done) return true;
-        if (path.empty()) { done = true; return true; }
-
-        Coord cur = path.top();
-        int x = cur.x, y = cur.y;
-        
-        // Colocar tesoros según progreso
-        if (challenges) {
-            float progress = static_cast<float>(visitedCount) / totalCells;
-            
-            if (!treasure1Placed && progress >= 0.33f) {
-                challenges->placeTreasureAt(cur);
-                treasure1Placed = true;
-            } else if (!treasure2Placed && progress >= 0.66f) {
-                challenges->placeTreasureAt(cur);
-                treasure2Placed = true;
-            } else if (!treasure3Placed && progress >= 0.90f) {
-                challenges->placeTreasureAt(cur);
-                treasure3Placed = true;
-            }
-        }
-        
-        int dir = g.pickRandomNeighborDir(x, y);
-        if (dir == -1) {
-            path.pop();
-        } else {
-            int nx = x, ny = y;
-            if (dir == 0) ny = y - 1;
-            else if (dir == 1) nx = x - 1;
-            else if (dir == 2) nx = x + 1;
-            else if (dir == 3) ny = y + 1;
+        while (!path.empty()) {
+            Coord cur = path.top();
+            int x = cur.x, y = cur.y;
 
-            g.removeWall(y, x, static_cast<short>(dir));
-            g.at(nx, ny).visited = true;
-            visitedCount++;
-            path.push(Coord(nx, ny));
-        }
+            // Colocar tesoros según progreso
+            treasures.update(visitedCount, cur);
 
-        if (path.empty()) done = true;
-        return done;
-    }
+            int dir = g.pickRandomNeighborDir(x, y);
+            if (dir == -1) {
+                path.pop();
+            } else {
+                int nx = x, ny = y;
+                if (dir == 0) ny = y - 1;
+                else if (dir == 1) nx = x - 1;
+                else if (dir == 2) nx = x + 1;
+                else if (dir == 3) ny = y + 1;
+
+                g.removeWall(y, x, static_cast<short>(dir));
+                g.at(nx, ny).visited = true;
+                visitedCount++;
+                path.push(Coord(nx, ny));
+            }
 
-    bool finished() const override { return done; }
-    bool getCurrent(Coord &out) const override { 
-        if (path.empty()) return false; 
-        out = path.top(); 
-        return true; 
+            if (!path.empty()) co_yield path.top();
+        }
     }
 };
 
-struct PrimsCollectorAlgorithm : public MazeAlgorithm {
-    Grid &g;
-    ChallengeSystem *challenges;
+struct PrimsCollectorAlgorithm : public CoroutineMazeAlgorithm {
     struct Frontier { int cx, cy, dir; };
-    std::vector<Frontier> frontier;
-    bool done = false;
-    Coord lastCarved;
-    int visitedCount = 0;
-    int totalCells;
-    bool treasure1Placed = false;
-    bool treasure2Placed = false;
-    bool treasure3Placed = false;
-
-    PrimsCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr) 
-        : g(grid), challenges(cs), totalCells(grid.width() * grid.height()) {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        
-        int sx = g.width() / 2;
-        int sy = g.height() / 2;
-        g.at(sx, sy).visited = true;
-        visitedCount = 1;
-        addFrontierFrom(sx, sy);
-        lastCarved = Coord(sx, sy);
-    }
 
-    void addFrontierFrom(int cx, int cy) {
+    PrimsCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr,
+                            unsigned seed = static_cast<unsigned>(std::time(nullptr)))
+        : CoroutineMazeAlgorithm(generate(grid, cs, seed)) {}
+
+    static void addFrontierFrom(const Grid &g, std::vector<Frontier> &frontier, int cx, int cy) {
         if (cy > 0 && !g.at(cx, cy - 1).visited) frontier.push_back({cx, cy, 0});
         if (cy < g.height() - 1 && !g.at(cx, cy + 1).visited) frontier.push_back({cx, cy, 3});
         if (cx > 0 && !g.at(cx - 1, cy).visited) frontier.push_back({cx, cy, 1});
         if (cx < g.width() - 1 && !g.at(cx + 1, cy).visited) frontier.push_back({cx, cy, 2});
     }
 
-    bool step() override {
-        if (done) return true;
+    static Generator<Coord> generate(Grid &g, ChallengeSystem *cs, unsigned seed) {
+        std::srand(seed);
+        TreasureSchedule treasures(cs, g);
+
+        int sx = g.width() / 2;
+        int sy = g.height() / 2;
+        g.at(sx, sy).visited = true;
+        int visitedCount = 1;
+        std::vector<Frontier> frontier;
+        addFrontierFrom(g, frontier, sx, sy);
+        co_yield Coord(sx, sy);
+
         while (!frontier.empty()) {
             int idx = std::rand() % frontier.size();
             Frontier f = frontier[idx];
@@ -157,66 +142,26 @@ struct PrimsCollectorAlgorithm : public MazeAlgorithm {
             g.removeWall(f.cy, f.cx, static_cast<short>(f.dir));
             g.at(nx, ny).visited = true;
             visitedCount++;
-            addFrontierFrom(nx, ny);
-            lastCarved = Coord(nx, ny);
-            
+            addFrontierFrom(g, frontier, nx, ny);
+
             // Colocar tesoros
-            if (challenges) {
-                float progress = static_cast<float>(visitedCount) / totalCells;
-                
-                if (!treasure1Placed && progress >= 0.33f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure1Placed = true;
-                } else if (!treasure2Placed && progress >= 0.66f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure2Placed = true;
-                } else if (!treasure3Placed && progress >= 0.90f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure3Placed = true;
-                }
-            }
+            Coord carved(nx, ny);
+            treasures.update(visitedCount, carved);
 
             frontier[idx] = frontier.back();
             frontier.pop_back();
 
-            if (frontier.empty()) done = true;
-            return false;
+            if (!frontier.empty()) co_yield carved;
         }
-
-        done = true;
-        return true;
-    }
-
-    bool finished() const override { return done; }
-    bool getCurrent(Coord &out) const override { 
-        if (done) return false; 
-        out = lastCarved; 
-        return true; 
     }
 };
 
-struct HuntAndKillCollectorAlgorithm : public MazeAlgorithm {
-    Grid &g;
-    ChallengeSystem *challenges;
-    int cx = 0, cy = 0;
-    bool done = false;
-    bool hunting = false;
-    int visitedCount = 0;
-    int totalCells;
-    bool treasure1Placed = false;
-    bool treasure2Placed = false;
-    bool treasure3Placed = false;
-
-    HuntAndKillCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr)
-        : g(grid), challenges(cs), totalCells(grid.width() * grid.height()) {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        cx = g.width() / 2;
-        cy = g.height() / 2;
-        g.at(cx, cy).visited = true;
-        visitedCount = 1;
-    }
+struct HuntAndKillCollectorAlgorithm : public CoroutineMazeAlgorithm {
+    HuntAndKillCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr,
+                                  unsigned seed = static_cast<unsigned>(std::time(nullptr)))
+        : CoroutineMazeAlgorithm(generate(grid, cs, seed)) {}
 
-    int pickRandomUnvisitedNeighborDir(int x, int y) const {
+    static int pickRandomUnvisitedNeighborDir(const Grid &g, int x, int y) {
         std::vector<int> dirs;
         if (y > 0 && !g.at(x, y - 1).visited) dirs.push_back(0);
         if (x > 0 && !g.at(x - 1, y).visited) dirs.push_back(1);
@@ -226,7 +171,7 @@ struct HuntAndKillCollectorAlgorithm : public MazeAlgorithm {
         return dirs[std::rand() % dirs.size()];
     }
 
-    int pickRandomVisitedNeighborDir(int x, int y) const {
+    static int pickRandomVisitedNeighborDir(const Grid &g, int x, int y) {
         std::vector<int> dirs;
         if (y > 0 && g.at(x, y - 1).visited) dirs.push_back(0);
         if (x > 0 && g.at(x - 1, y).visited) dirs.push_back(1);
@@ -236,13 +181,22 @@ struct HuntAndKillCollectorAlgorithm : public MazeAlgorithm {
         return dirs[std::rand() % dirs.size()];
     }
 
-    bool step() override {
-        if (done) return true;
+    // Como en HuntAndKillAlgorithm, la fase en curso (kill/hunt) es el punto
+    // donde quedó suspendida la corrutina
+    static Generator<Coord> generate(Grid &g, ChallengeSystem *cs, unsigned seed) {
+        std::srand(seed);
+        TreasureSchedule treasures(cs, g);
+
+        int cx = g.width() / 2;
+        int cy = g.height() / 2;
+        g.at(cx, cy).visited = true;
+        int visitedCount = 1;
+        co_yield Coord(cx, cy);
 
-        // Kill phase
-        if (!hunting) {
-            int dir = pickRandomUnvisitedNeighborDir(cx, cy);
-            if (dir != -1) {
+        while (true) {
+            // Kill phase
+            int dir;
+            while ((dir = pickRandomUnvisitedNeighborDir(g, cx, cy)) != -1) {
                 int nx = cx, ny = cy;
                 if (dir == 0) ny--;
                 else if (dir == 1) nx--;
@@ -253,160 +207,98 @@ struct HuntAndKillCollectorAlgorithm : public MazeAlgorithm {
                 g.at(nx, ny).visited = true;
                 visitedCount++;
                 cx = nx; cy = ny;
-                
+
                 // Colocar tesoros
-                if (challenges) {
-                    float progress = static_cast<float>(visitedCount) / totalCells;
-                    Coord current(cx, cy);
-                    
-                    if (!treasure1Placed && progress >= 0.33f) {
-                        challenges->placeTreasureAt(current);
-                        treasure1Placed = true;
-                    } else if (!treasure2Placed && progress >= 0.66f) {
-                        challenges->placeTreasureAt(current);
-                        treasure2Placed = true;
-                    } else if (!treasure3Placed && progress >= 0.90f) {
-                        challenges->placeTreasureAt(current);
-                        treasure3Placed = true;
-                    }
-                }
-                
-                return false;
-            } else {
-                hunting = true;
-                return false;
+                treasures.update(visitedCount, Coord(cx, cy));
+                co_yield Coord(cx, cy);
             }
-        }
 
-        // Hunt phase
-        for (int y = 0; y < g.height(); ++y) {
-            for (int x = 0; x < g.width(); ++x) {
-                if (!g.at(x, y).visited) {
-                    int vdir = pickRandomVisitedNeighborDir(x, y);
-                    if (vdir != -1) {
-                        g.removeWall(y, x, static_cast<short>(vdir));
-                        g.at(x, y).visited = true;
-                        visitedCount++;
-                        cx = x; cy = y;
-                        hunting = false;
-                        return false;
-                    }
+            // Hunt phase
+            bool found = false;
+            for (int y = 0; y < g.height() && !found; ++y) {
+                for (int x = 0; x < g.width() && !found; ++x) {
+                    if (g.at(x, y).visited) continue;
+                    int vdir = pickRandomVisitedNeighborDir(g, x, y);
+                    if (vdir == -1) continue;
+
+                    g.removeWall(y, x, static_cast<short>(vdir));
+                    g.at(x, y).visited = true;
+                    visitedCount++;
+                    cx = x; cy = y;
+                    found = true;
                 }
             }
-        }
-
-        done = true;
-        return true;
-    }
-
-    bool finished() const override { return done; }
 
-    bool getCurrent(Coord &out) const override {
-        if (done) return false;
-        out = Coord(cx, cy);
-        return true;
+            if (!found) co_return;
+            co_yield Coord(cx, cy);
+        }
     }
 };
 
-struct KruskalsCollectorAlgorithm : public MazeAlgorithm {
-    Grid &g;
-    ChallengeSystem *challenges;
+struct KruskalsCollectorAlgorithm : public CoroutineMazeAlgorithm {
     struct Edge { int x, y; int dir; int w; };
     struct EdgeLess { bool operator()(const Edge &a, const Edge &b) const { return a.w > b.w; } };
-    std::priority_queue<Edge, std::vector<Edge>, EdgeLess> pq;
 
-    std::vector<int> parent;
-    std::vector<int> rnk;
-    bool done = false;
-    Coord lastCarved;
-    int visitedCount = 0;
-    int totalCells;
-    bool treasure1Placed = false;
-    bool treasure2Placed = false;
-    bool treasure3Placed = false;
+    KruskalsCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr,
+                               unsigned seed = static_cast<unsigned>(std::time(nullptr)))
+        : CoroutineMazeAlgorithm(generate(grid, cs, seed)) {}
+
+    static int find(std::vector<int> &parent, int a) {
+        if (parent[a] != a) parent[a] = find(parent, parent[a]);
+        return parent[a];
+    }
+
+    static void unite(std::vector<int> &parent, std::vector<int> &rnk, int a, int b) {
+        a = find(parent, a); b = find(parent, b);
+        if (a == b) return;
+        if (rnk[a] < rnk[b]) std::swap(a, b);
+        parent[b] = a;
+        if (rnk[a] == rnk[b]) rnk[a]++;
+    }
 
-    KruskalsCollectorAlgorithm(Grid &grid, ChallengeSystem *cs = nullptr)
-        : g(grid), challenges(cs), totalCells(grid.width() * grid.height()) {
+    static Generator<Coord> generate(Grid &g, ChallengeSystem *cs, unsigned seed) {
         const int W = g.width(), H = g.height();
         const int N = W * H;
-        parent.resize(N); rnk.assign(N, 0);
+        TreasureSchedule treasures(cs, g);
+        std::vector<int> parent(N);
+        std::vector<int> rnk(N, 0);
         for (int i = 0; i < N; ++i) parent[i] = i;
 
-        std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
+        std::mt19937 rng(seed);
         std::uniform_int_distribution<int> dist(1, 1000000);
 
+        std::priority_queue<Edge, std::vector<Edge>, EdgeLess> pq;
         for (int y = 0; y < H; ++y) {
             for (int x = 0; x < W; ++x) {
                 if (x + 1 < W) pq.push(Edge{x, y, 2, dist(rng)});
                 if (y + 1 < H) pq.push(Edge{x, y, 3, dist(rng)});
             }
         }
-        
-        lastCarved = Coord(W/2, H/2);
-    }
-
-    int idx(int x, int y) const { return y * g.width() + x; }
-
-    int find(int a) {
-        if (parent[a] != a) parent[a] = find(parent[a]);
-        return parent[a];
-    }
-
-    void unite(int a, int b) {
-        a = find(a); b = find(b);
-        if (a == b) return;
-        if (rnk[a] < rnk[b]) std::swap(a, b);
-        parent[b] = a;
-        if (rnk[a] == rnk[b]) rnk[a]++;
-    }
-
-    bool step() override {
-        if (done) return true;
-        if (pq.empty()) { done = true; return true; }
-
-        Edge e = pq.top(); pq.pop();
-        int x = e.x, y = e.y;
-        int nx = x, ny = y;
-        if (e.dir == 2) nx = x + 1; else if (e.dir == 3) ny = y + 1;
+        co_yield Coord(W / 2, H / 2);
+
+        // Con N - 1 uniones el árbol está completo: el resto de la cola solo cerraría ciclos
+        int visitedCount = 0;
+        int unions = 0;
+        while (!pq.empty() && unions < N - 1) {
+            Edge e = pq.top(); pq.pop();
+            int x = e.x, y = e.y;
+            int nx = x, ny = y;
+            if (e.dir == 2) nx = x + 1; else if (e.dir == 3) ny = y + 1;
 
-        int a = idx(x, y);
-        int b = idx(nx, ny);
+            int a = y * W + x;
+            int b = ny * W + nx;
+            if (find(parent, a) == find(parent, b)) continue;
 
-        if (find(a) != find(b)) {
             g.removeWall(y, x, static_cast<short>(e.dir));
-            unite(a, b);
+            unite(parent, rnk, a, b);
             g.at(x, y).visited = true;
             g.at(nx, ny).visited = true;
             visitedCount += 2;
-            lastCarved = Coord(nx, ny);
-            
+
             // Colocar tesoros
-            if (challenges) {
-                float progress = static_cast<float>(visitedCount) / totalCells;
-                
-                if (!treasure1Placed && progress >= 0.33f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure1Placed = true;
-                } else if (!treasure2Placed && progress >= 0.66f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure2Placed = true;
-                } else if (!treasure3Placed && progress >= 0.90f) {
-                    challenges->placeTreasureAt(lastCarved);
-                    treasure3Placed = true;
-                }
-            }
-            
-            return false;
+            Coord carved(nx, ny);
+            treasures.update(visitedCount, carved);
+            if (++unions < N - 1) co_yield carved;
         }
-
-        if (pq.empty()) done = true;
-        return done;
     }
-
-    bool finished() const override { return done; }
-    bool getCurrent(Coord &out) const override {
-        if (done) return false;
-        out = lastCarved;
-        return true;
-    }
-};
\ No newline at end of file
+};
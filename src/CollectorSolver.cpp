@@ -1,34 +1,28 @@
 #include "CollectorSolver.h"
 #include <cmath>
 #include <algorithm>
+#include <queue>
 #include <random>
 
-CollectorSolver::CollectorSolver(Grid& grid, ChallengeSystem& chall, Coord s, Coord fg, SolverStrategy strat)
+CollectorSolver::CollectorSolver(const Grid& grid, ChallengeSystem& chall, Coord s, Coord fg, SolverStrategy strat)
     : g(grid), challenges(chall), start(s), finalGoal(fg), strategy(strat),
       heatmap(grid.width(), grid.height()),  // ✅ Inicializar heatmap (ESTRUCTURA 2/3)
-      stateGrid(grid.width(), std::vector<CellState>(grid.height(), UNKNOWN)),
-      closed(grid.width(), std::vector<bool>(grid.height(), false)),
-      gScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      fScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      cameFrom(grid.width(), std::vector<Coord>(grid.height(), Coord(-1,-1))),
-      dfsVisited(grid.width(), std::vector<bool>(grid.height(), false)),
-      currentPos(s) {
-    
-    // Greedy mejorado: ordenar tesoros
-    objectives = greedyOrderTreasures(start, challenges.getTreasurePositions(), finalGoal);
-    objectives.push_back(finalGoal);
-    
-    currentSegment.objectiveIndex = 0;
-    
-    if (!objectives.empty()) {
-        currentGoal = objectives[0];
-        if (strategy == SolverStrategy::DFS) {
-            initializeDFS(start, currentGoal);
+      state(grid.width(), grid.height()),
+      currentPos(s),
+      events(run()) {  // Arranca suspendida: el primer step() prepara el primer tramo
+    
+    nearestObjectiveMode = challenges.remainingTreasures() > NEAREST_OBJECTIVE_THRESHOLD;
+    {
+        // Planificar objetivos cuenta como inicialización (no como búsqueda)
+        PhaseTimer planTimer(stats.initTime);
+        if (nearestObjectiveMode) {
+            // Muchos tesoros: elegir el siguiente objetivo al terminar cada tramo
+            objectives.push_back(nextNearestObjective(start));
         } else {
-            initializeSearch(start, currentGoal);
+            // Greedy mejorado: ordenar tesoros
+            objectives = greedyOrderTreasures(start, challenges.getTreasurePositions(), finalGoal);
+            objectives.push_back(finalGoal);
         }
-    } else {
-        allDone = true;
     }
 }
 
@@ -70,43 +64,40 @@ std::vector<Coord> CollectorSolver::greedyOrderTreasures(
     return ordered;
 }
 
-void CollectorSolver::initializeSearch(Coord from, Coord to) {
-    // Limpieza completa
-    closed.assign(g.width(), std::vector<bool>(g.height(), false));
-    gScore.assign(g.width(), std::vector<float>(g.height(), std::numeric_limits<float>::infinity()));
-    fScore.assign(g.width(), std::vector<float>(g.height(), std::numeric_limits<float>::infinity()));
-    cameFrom.assign(g.width(), std::vector<Coord>(g.height(), Coord(-1,-1)));
-    stateGrid.assign(g.width(), std::vector<CellState>(g.height(), UNKNOWN));
-    
-    while (!openPQ.empty()) openPQ.pop();
-    pushCounter = 0;
-    
-    currentPos = from;
-    currentGoal = to;
-    gScore[from.x][from.y] = 0.0f;
-    fScore[from.x][from.y] = heuristic(from.x, from.y, to);
-    openPQ.push({fScore[from.x][from.y], pushCounter++, from.x, from.y});
-    stateGrid[from.x][from.y] = OPEN;
-    
-    segmentDone = false;
-    currentSegmentPath.clear();
-}
+void CollectorSolver::beginSegment(Coord to) {
+    PhaseTimer initTimer(stats.initTime);
 
-void CollectorSolver::initializeDFS(Coord from, Coord to) {
-    dfsVisited.assign(g.width(), std::vector<bool>(g.height(), false));
-    stateGrid.assign(g.width(), std::vector<CellState>(g.height(), UNKNOWN));
-    
-    dfsStack.clear();
-    dfsStack.push_back(from);
-    dfsVisited[from.x][from.y] = true;
-    stateGrid[from.x][from.y] = OPEN;
-    
-    currentPos = from;
+    // Limpieza completa (solo planos de bits)
+    state.reset();
+
+    Coord from = currentPos;
     currentGoal = to;
-    segmentDone = false;
+    segmentStart = from;
+    currentSegment = PathSegment();
+    currentSegment.objectiveIndex = currentObjectiveIndex;
     currentSegmentPath.clear();
+
+    if (strategy == SolverStrategy::DEADEND_FILL) {
+        deadEndFill = std::make_unique<DeadEndFillSolver>(g, from, to);
+    } else if (strategy == SolverStrategy::DFS) {
+        dfsStack.clear();
+        dfsStack.push_back(from);
+        stats.notePush(dfsStack.size());
+        state.setState(from.x, from.y, CompactSearchState::OPEN);
+    } else {
+        while (!openPQ.empty()) openPQ.pop();
+        pushCounter = 0;
+
+        state.setState(from.x, from.y, CompactSearchState::OPEN);
+        state.setDistance(from.x, from.y, 0);
+        state.clearParent(from.x, from.y);
+        openPQ.push({heuristic(from.x, from.y, to), pushCounter++, from.x, from.y});
+        stats.heuristicEvals++;
+        stats.notePush(openPQ.size());
+    }
 }
 
+
 float CollectorSolver::heuristic(int x, int y, const Coord& goal) const {
     return static_cast<float>(std::abs(goal.x - x) + std::abs(goal.y - y));
 }
@@ -114,10 +105,12 @@ float CollectorSolver::heuristic(int x, int y, const Coord& goal) const {
 void CollectorSolver::checkOpportunisticCollection() {
     if (challenges.hasTreasure(currentPos)) {
         // ¿Es un tesoro que NO es mi objetivo actual?
-        if (!(currentPos.x == currentGoal.x && currentPos.y == currentGoal.y)) {
+        // (en modo concurrente otro recolector pudo ganarlo antes)
+        if (!(currentPos.x == currentGoal.x && currentPos.y == currentGoal.y) &&
+            challenges.collectTreasure(currentPos)) {
             // ¡Tesoro de paso encontrado!
-            challenges.collectTreasure(currentPos);
-            stateGrid[currentPos.x][currentPos.y] = TREASURE_COLLECTED;
+            treasuresCollected++;
+            state.setState(currentPos.x, currentPos.y, CompactSearchState::MARKED);
             
             // Marcar en el segmento actual
             currentSegment.foundBonus = true;
@@ -129,7 +122,43 @@ void CollectorSolver::checkOpportunisticCollection() {
     }
 }
 
+Coord CollectorSolver::nextNearestObjective(const Coord& from) const {
+    std::optional<Coord> nearest = reachable.empty()
+        ? challenges.nearestTreasure(from)
+        : challenges.nearestTreasure(from, [this](const Coord& c) { return reachable[c.y * g.width() + c.x] != 0; });
+    return nearest ? *nearest : finalGoal;
+}
+
+void CollectorSolver::markReachable(Coord from) {
+    // BFS sobre los pasajes abiertos: la componente en la que está el recolector
+    reachable.assign(static_cast<size_t>(g.width()) * g.height(), 0);
+    std::queue<Coord> frontier;
+    reachable[from.y * g.width() + from.x] = 1;
+    frontier.push(from);
+
+    while (!frontier.empty()) {
+        Coord cur = frontier.front();
+        frontier.pop();
+        for (int dir = 0; dir < 4; ++dir) {
+            if (g.at(cur.x, cur.y).walls[dir]) continue;
+            int nx = cur.x, ny = cur.y;
+            if (dir == 0) ny -= 1;
+            else if (dir == 1) nx -= 1;
+            else if (dir == 2) nx += 1;
+            else if (dir == 3) ny += 1;
+
+            if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
+            char& seen = reachable[ny * g.width() + nx];
+            if (seen) continue;
+            seen = 1;
+            frontier.push(Coord(nx, ny));
+        }
+    }
+}
+
 void CollectorSolver::removeFromObjectives(const Coord& pos) {
+    // En modo "más cercano" no hay objetivos futuros: el índice ya no lo tiene
+    if (nearestObjectiveMode) return;
     for (size_t i = currentObjectiveIndex + 1; i < objectives.size(); ++i) {
         if (objectives[i].x == pos.x && objectives[i].y == pos.y) {
             objectives.erase(objectives.begin() + i);
@@ -139,229 +168,170 @@ void CollectorSolver::removeFromObjectives(const Coord& pos) {
 }
 // CollectorSolver.cpp PARTE 2 - Continúa de part1
 
-bool CollectorSolver::step() {
-    if (allDone) return true;
-    
-    if (segmentDone) {
-        // Guardar segmento completado
-        segments.push_back(currentSegment);
-        
-        // Pasar al siguiente objetivo
-        currentObjectiveIndex++;
-        
-        if (currentObjectiveIndex >= static_cast<int>(objectives.size())) {
-            allDone = true;
-            return true;
-        }
-        
-        // Preparar nuevo segmento
-        currentSegment = PathSegment();
-        currentSegment.objectiveIndex = currentObjectiveIndex;
-        
-        Coord nextGoal = objectives[currentObjectiveIndex];
-        if (strategy == SolverStrategy::DFS) {
-            initializeDFS(currentPos, nextGoal);
-        } else {
-            initializeSearch(currentPos, nextGoal);
-        }
-        return false;
-    }
+Generator<Coord> CollectorSolver::run() {
+    while (currentObjectiveIndex < static_cast<int>(objectives.size())) {
+        beginSegment(objectives[currentObjectiveIndex]);
 
-    switch (strategy) {
-        case SolverStrategy::ASTAR:
-            return stepAStar();
-        case SolverStrategy::GREEDY:
-            return stepGreedy();
-        case SolverStrategy::UCS:
-            return stepUCS();
-        case SolverStrategy::DFS:
-            return stepDFS();
-    }
-    
-    return false;
-}
+        // ¿Ya se resolvió este tramo en este laberinto? (DFS es aleatorio: no se cachea)
+        const bool fromCache = pathCache && strategy != SolverStrategy::DFS &&
+            pathCache->get({g.wallHash(), segmentStart, currentGoal, strategy}, currentSegmentPath);
 
-bool CollectorSolver::stepAStar() {
-    if (openPQ.empty()) {
-        segmentDone = true;
-        return false;
-    }
-    
-    PQNode node;
-    do {
-        if (openPQ.empty()) {
-            segmentDone = true;
-            return false;
-        }
-        node = openPQ.top();
-        openPQ.pop();
-    } while (closed[node.x][node.y]);
-    
-    int cx = node.x, cy = node.y;
-    currentPos = Coord(cx, cy);
+        // ¿El tramo terminó con un evento aún sin emitir? (llegada al objetivo,
+        // última pasada del relleno o recorrido de la caché)
+        bool pendingEvent = true;
 
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
-    nodesExpandedCount++;  // Incrementar contador
+        if (fromCache) {
+            stats.cacheHits++;
+            walkSegmentPath(true);
+        } else if (strategy == SolverStrategy::DEADEND_FILL) {
+            // Cada evento es una pasada de relleno sobre todo el laberinto
+            for (;;) {
+                int filledBefore = deadEndFill->getFilledCount();
+                bool fillDone = deadEndFill->step();
+                nodesExpandedCount += deadEndFill->getFilledCount() - filledBefore;
+                if (fillDone) break;
+                co_yield currentPos;
+            }
 
-    heatmap.recordVisit(cx, cy);
+            // Sumar los contadores del relleno (la memoria se cuenta en getSearchStats)
+            SearchStats fillStats = deadEndFill->getSearchStats();
+            fillStats.bytesAllocated = 0;
+            stats += fillStats;
 
-    checkOpportunisticCollection();
-    
-    // ¿Llegamos al objetivo?
-    if (cx == currentGoal.x && cy == currentGoal.y) {
-        reconstructSegment();
-        
-        if (challenges.hasTreasure(currentGoal)) {
-            challenges.collectTreasure(currentGoal);
-            stateGrid[cx][cy] = TREASURE_COLLECTED;
-        }
-        
-        segmentDone = true;
-        return false;
-    }
-    
-    // Expandir vecinos
-    for (int dir = 0; dir < 4; ++dir) {
-        if (g.at(cx, cy).walls[dir]) continue;
-        
-        int nx = cx, ny = cy;
-        if (dir == 0) ny -= 1;
-        else if (dir == 1) nx -= 1;
-        else if (dir == 2) nx += 1;
-        else if (dir == 3) ny += 1;
-        
-        if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
-        
-        float tentative_g = gScore[cx][cy] + 1.0f;
-        
-        if (tentative_g < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_g;
-            fScore[nx][ny] = tentative_g + heuristic(nx, ny, currentGoal);
-            
-            // ✅ Solo agregar si es nuevo (no está en OPEN ni CLOSED)
-            if (stateGrid[nx][ny] == UNKNOWN) {
-                openPQ.push({fScore[nx][ny], pushCounter++, nx, ny});
-                stateGrid[nx][ny] = OPEN;
+            currentSegmentPath = deadEndFill->getSolution();
+            walkSegmentPath(false);
+        } else {
+            // A*/Greedy/UCS/DFS: un evento por celda expandida
+            searchSpan.begin();
+            pendingEvent = false;
+            Coord cur;
+            while (popFrontier(cur)) {
+                expandCell(cur);
+                if (cur == currentGoal) {
+                    pendingEvent = true;
+                    break;
+                }
+                pushNeighbors(cur);
+                co_yield currentPos;
+            }
+            searchSpan.end(stats.searchTime);
+
+            if (pendingEvent) {
+                if (strategy == SolverStrategy::DFS) {
+                    // DFS no usa cameFrom: el tramo es solo el objetivo
+                    currentSegmentPath.assign(1, currentGoal);
+                    fullPath.push_back(currentGoal);
+                    currentSegment.path = currentSegmentPath;
+                } else {
+                    reconstructSegment();
+                }
+                collectGoal();
             }
-            // Si ya está OPEN: scores actualizados, pero nodo ya en cola
-            // La próxima vez que se procese usará los nuevos scores
+        }
+
+        closeSegment(fromCache);
+
+        // El evento de cierre sale con el siguiente objetivo ya elegido: así el
+        // step() que llega a la meta final es también el que termina
+        if (pendingEvent && currentObjectiveIndex < static_cast<int>(objectives.size())) {
+            co_yield currentPos;
         }
     }
-    
-    return false;
 }
 
-bool CollectorSolver::stepGreedy() {
-    if (openPQ.empty()) {
-        segmentDone = true;
-        return false;
+void CollectorSolver::closeSegment(bool fromCache) {
+    // Tramo fallido (objetivo inalcanzable): el recolector no se movió.
+    // Sin esto, en modo "más cercano" se vuelve a elegir el mismo tesoro
+    // para siempre; con 'reachable' ya no se eligen tesoros de otra componente
+    if (currentSegment.path.empty()) {
+        currentPos = segmentStart;
+        if (nearestObjectiveMode && reachable.empty()) markReachable(segmentStart);
     }
-    
-    PQNode node;
-    do {
-        if (openPQ.empty()) {
-            segmentDone = true;
-            return false;
-        }
-        node = openPQ.top();
-        openPQ.pop();
-    } while (closed[node.x][node.y]);
-    
-    int cx = node.x, cy = node.y;
-    currentPos = Coord(cx, cy);
-
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
-    nodesExpandedCount++;  // Incrementar contador
 
-    heatmap.recordVisit(cx, cy);
+    // Guardar segmento completado
+    segments.push_back(currentSegment);
 
-    checkOpportunisticCollection();
-    
-    if (cx == currentGoal.x && cy == currentGoal.y) {
-        reconstructSegment();
-        
-        if (challenges.hasTreasure(currentGoal)) {
-            challenges.collectTreasure(currentGoal);
-            stateGrid[cx][cy] = TREASURE_COLLECTED;
-        }
-        
-        segmentDone = true;
-        return false;
+    // DFS es aleatorio: no se cachea
+    if (pathCache && !fromCache && strategy != SolverStrategy::DFS &&
+        !currentSegment.path.empty()) {
+        pathCache->put({g.wallHash(), segmentStart, currentGoal, strategy}, currentSegment.path);
     }
     
-    for (int dir = 0; dir < 4; ++dir) {
-        if (g.at(cx, cy).walls[dir]) continue;
-        
-        int nx = cx, ny = cy;
-        if (dir == 0) ny -= 1;
-        else if (dir == 1) nx -= 1;
-        else if (dir == 2) nx += 1;
-        else if (dir == 3) ny += 1;
-        
-        if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
-        
-        float tentative_g = gScore[cx][cy] + 1.0f;
-        
-        if (tentative_g < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_g;
-            fScore[nx][ny] = heuristic(nx, ny, currentGoal);
-            
-            // ✅ Solo agregar si es nuevo
-            if (stateGrid[nx][ny] == UNKNOWN) {
-                openPQ.push({fScore[nx][ny], pushCounter++, nx, ny});
-                stateGrid[nx][ny] = OPEN;
-            }
+    // Pasar al siguiente objetivo
+    currentObjectiveIndex++;
+    
+    // Modo "más cercano": agregar el próximo hasta llegar a la meta final
+    if (nearestObjectiveMode && currentObjectiveIndex >= static_cast<int>(objectives.size())) {
+        const Coord& reached = objectives.back();
+        if (!(reached.x == finalGoal.x && reached.y == finalGoal.y)) {
+            objectives.push_back(nextNearestObjective(currentPos));
         }
     }
-    
-    return false;
 }
 
-bool CollectorSolver::stepUCS() {
-    if (openPQ.empty()) {
-        segmentDone = true;
-        return false;
+bool CollectorSolver::popFrontier(Coord& out) {
+    if (strategy == SolverStrategy::DFS) {
+        if (dfsStack.empty()) return false;
+        out = dfsStack.back();
+        dfsStack.pop_back();
+        stats.pops++;
+        return true;
     }
-    
+
+    // Las entradas de celdas ya cerradas se descartan sin contar como expansión
     PQNode node;
     do {
-        if (openPQ.empty()) {
-            segmentDone = true;
-            return false;
-        }
+        if (openPQ.empty()) return false;
         node = openPQ.top();
         openPQ.pop();
-    } while (closed[node.x][node.y]);
-    
-    int cx = node.x, cy = node.y;
-    currentPos = Coord(cx, cy);
+        if (state.isClosed(node.x, node.y)) stats.stalePops++;
+    } while (state.isClosed(node.x, node.y));
+    stats.pops++;
+
+    out = Coord(node.x, node.y);
+    return true;
+}
 
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
+void CollectorSolver::expandCell(const Coord& cell) {
+    currentPos = cell;
+    state.setState(cell.x, cell.y, CompactSearchState::CLOSED);
     nodesExpandedCount++;  // Incrementar contador
 
-    heatmap.recordVisit(cx, cy);
+    heatmap.recordVisit(cell.x, cell.y);
 
     checkOpportunisticCollection();
-    
-    if (cx == currentGoal.x && cy == currentGoal.y) {
-        reconstructSegment();
+}
+
+void CollectorSolver::pushNeighbors(const Coord& cell) {
+    int cx = cell.x, cy = cell.y;
+
+    if (strategy == SolverStrategy::DFS) {
+        // Expandir vecinos en orden aleatorio (característica DFS)
+        std::vector<int> dirs = {0, 1, 2, 3};
+        // Un generador por hilo: varios solvers pueden correr en paralelo (benchmark)
+        static thread_local std::mt19937 rng(std::random_device{}());
+        std::shuffle(dirs.begin(), dirs.end(), rng);
         
-        if (challenges.hasTreasure(currentGoal)) {
-            challenges.collectTreasure(currentGoal);
-            stateGrid[cx][cy] = TREASURE_COLLECTED;
+        for (int dir : dirs) {
+            if (g.at(cx, cy).walls[dir]) continue;
+            
+            int nx = cx, ny = cy;
+            if (dir == 0) ny -= 1;
+            else if (dir == 1) nx -= 1;
+            else if (dir == 2) nx += 1;
+            else if (dir == 3) ny += 1;
+            
+            if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
+            if (state.isReached(nx, ny)) continue;
+            
+            dfsStack.push_back(Coord(nx, ny));
+            stats.notePush(dfsStack.size());
+            state.setState(nx, ny, CompactSearchState::OPEN);
         }
-        
-        segmentDone = true;
-        return false;
+        return;
     }
-    
+
+    // A*/Greedy/UCS: misma relajación, solo cambia la prioridad en la cola
     for (int dir = 0; dir < 4; ++dir) {
         if (g.at(cx, cy).walls[dir]) continue;
         
@@ -372,105 +342,70 @@ bool CollectorSolver::stepUCS() {
         else if (dir == 3) ny += 1;
         
         if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
+        if (state.isClosed(nx, ny)) continue;
         
-        float tentative_g = gScore[cx][cy] + 1.0f;
+        std::uint32_t tentative_g = state.getDistance(cx, cy) + 1;
         
-        if (tentative_g < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_g;
-            fScore[nx][ny] = tentative_g;
+        if (tentative_g < state.getDistance(nx, ny)) {
+            bool isNew = !state.isReached(nx, ny);
+            if (!isNew) stats.reopenings++;
+            state.setParentDir(nx, ny, CompactSearchState::oppositeDir(dir));
+            if (isNew) state.setState(nx, ny, CompactSearchState::OPEN);
+            state.setDistance(nx, ny, tentative_g);
             
-            // ✅ Solo agregar si es nuevo
-            if (stateGrid[nx][ny] == UNKNOWN) {
-                openPQ.push({fScore[nx][ny], pushCounter++, nx, ny});
-                stateGrid[nx][ny] = OPEN;
+            // ✅ Solo agregar si es nuevo (no está en OPEN ni CLOSED).
+            // Si ya está OPEN: scores actualizados, pero nodo ya en cola;
+            // la próxima vez que se procese usará los nuevos scores
+            if (isNew) {
+                float priority;
+                if (strategy == SolverStrategy::UCS) {
+                    priority = static_cast<float>(tentative_g);
+                } else {
+                    priority = heuristic(nx, ny, currentGoal);
+                    if (strategy == SolverStrategy::ASTAR) priority += static_cast<float>(tentative_g);
+                    stats.heuristicEvals++;
+                }
+                openPQ.push({priority, pushCounter++, nx, ny});
+                stats.notePush(openPQ.size());
             }
         }
     }
-    
-    return false;
 }
-// CollectorSolver.cpp PARTE 3 - Continúa de part2
-
-// ===================================
-// DEPTH-FIRST SEARCH
-// ===================================
-bool CollectorSolver::stepDFS() {
-    if (dfsStack.empty()) {
-        segmentDone = true;
-        return false;
+
+void CollectorSolver::collectGoal() {
+    if (challenges.collectTreasure(currentGoal)) {
+        treasuresCollected++;
+        state.setState(currentGoal.x, currentGoal.y, CompactSearchState::MARKED);
     }
-    
-    Coord cur = dfsStack.back();
-    dfsStack.pop_back();
-    
-    int cx = cur.x, cy = cur.y;
-    currentPos = cur;
-    stateGrid[cx][cy] = CLOSED;
-    nodesExpandedCount++;  // Incrementar contador
+}
 
-    heatmap.recordVisit(cx, cy);  // ✅ Registrar en heatmap
+void CollectorSolver::walkSegmentPath(bool fromCache) {
+    // Camino ya conocido (corredor del relleno o caché): recorrerlo
+    // recolectando tesoros de paso, sin explorar
+    if (currentSegmentPath.empty()) return;
 
-    checkOpportunisticCollection();
-    
-    // ¿Llegamos al objetivo?
-    if (cx == currentGoal.x && cy == currentGoal.y) {
-        // DFS no usa cameFrom, construir camino desde stack
-        currentSegmentPath.clear();
-        currentSegmentPath.push_back(currentGoal);
-        
-        // Agregar al fullPath
-        fullPath.push_back(currentGoal);
-        
-        // Guardar en segmento
-        currentSegment.path = currentSegmentPath;
-        
-        if (challenges.hasTreasure(currentGoal)) {
-            challenges.collectTreasure(currentGoal);
-            stateGrid[cx][cy] = TREASURE_COLLECTED;
-        }
-        
-        segmentDone = true;
-        return false;
+    for (const Coord& c : currentSegmentPath) {
+        currentPos = c;
+        state.setState(c.x, c.y, CompactSearchState::CLOSED);
+        // Un tramo de la caché no se buscó: sus celdas van aparte para no
+        // mezclar recorridos repetidos con expansiones reales en el ranking
+        if (fromCache) stats.cachedCells++;
+        else nodesExpandedCount++;
+        heatmap.recordVisit(c.x, c.y);
+        checkOpportunisticCollection();
     }
-    
-    // Expandir vecinos en orden aleatorio (característica DFS)
-    std::vector<int> dirs = {0, 1, 2, 3};
-    static std::random_device rd;
-    static std::mt19937 rng(rd());
-    std::shuffle(dirs.begin(), dirs.end(), rng);
-    
-    for (int dir : dirs) {
-        if (g.at(cx, cy).walls[dir]) continue;
-        
-        int nx = cx, ny = cy;
-        if (dir == 0) ny -= 1;
-        else if (dir == 1) nx -= 1;
-        else if (dir == 2) nx += 1;
-        else if (dir == 3) ny += 1;
-        
-        if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (dfsVisited[nx][ny]) continue;
-        
-        dfsVisited[nx][ny] = true;
-        dfsStack.push_back(Coord(nx, ny));
-        stateGrid[nx][ny] = OPEN;
+
+    currentSegment.path = currentSegmentPath;
+    for (size_t i = (fullPath.empty() ? 0 : 1); i < currentSegmentPath.size(); ++i) {
+        fullPath.push_back(currentSegmentPath[i]);
     }
-    
-    return false;
+
+    collectGoal();
 }
 
 void CollectorSolver::reconstructSegment() {
-    currentSegmentPath.clear();
-    Coord cur = currentGoal;
-    
-    while (!(cur.x == -1 && cur.y == -1)) {
-        currentSegmentPath.push_back(cur);
-        cur = cameFrom[cur.x][cur.y];
-    }
-    
-    std::reverse(currentSegmentPath.begin(), currentSegmentPath.end());
+    PhaseTimer pathTimer(stats.reconstructTime);
+    currentSegmentPath = state.tracePath(currentGoal);
     
     // Guardar en segmento actual
     currentSegment.path = currentSegmentPath;
@@ -481,12 +416,17 @@ void CollectorSolver::reconstructSegment() {
     }
 }
 
+bool CollectorSolver::step() {
+    events.next();
+    return events.done();
+}
+
 bool CollectorSolver::finished() const {
-    return allDone;
+    return events.done();
 }
 
 bool CollectorSolver::getCurrent(Coord& out) const {
-    if (allDone) return false;
+    if (events.done()) return false;
     out = currentPos;
     return true;
 }
@@ -499,6 +439,14 @@ const std::vector<PathSegment>& CollectorSolver::getSegments() const {
     return segments;
 }
 
+SearchStats CollectorSolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.bytesAllocated = state.bytesUsed() + static_cast<size_t>(stats.peakOpen) * sizeof(PQNode)
+                       + fullPath.size() * sizeof(Coord);
+    if (deadEndFill) out.bytesAllocated += deadEndFill->getSearchStats().bytesAllocated;
+    return out;
+}
+
 int CollectorSolver::getTreasuresCollected() const {
-    return challenges.collectedCount;
+    return treasuresCollected;
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "CompactSearchState.h"
+#include "PortalSystem.h"
+#include <algorithm>
+
+CompactSearchState::CompactSearchState(int width, int height)
+    : w(width), h(height) {
+    size_t cells = static_cast<size_t>(w) * h;
+    size_t words = (cells + 63) / 64;
+
+    openBits.assign(words, 0);
+    closedBits.assign(words, 0);
+    hasParentBits.assign(words, 0);
+    portalBits.assign(words, 0);
+    parentDirs.assign((cells + 3) / 4, 0);
+
+    // Un camino simple tiene a lo sumo (celdas - 1) pasos: elegir el ancho mínimo
+    if (cells <= std::numeric_limits<std::uint8_t>::max()) {
+        distBytes = 1;
+        dist8.assign(cells, 0);
+    } else if (cells <= std::numeric_limits<std::uint16_t>::max()) {
+        distBytes = 2;
+        dist16.assign(cells, 0);
+    } else {
+        distBytes = 4;
+        dist32.assign(cells, 0);
+    }
+}
+
+void CompactSearchState::reset() {
+    // Distancias y direcciones quedan con basura, pero solo se leen en celdas alcanzadas
+    std::fill(openBits.begin(), openBits.end(), 0);
+    std::fill(closedBits.begin(), closedBits.end(), 0);
+    std::fill(hasParentBits.begin(), hasParentBits.end(), 0);
+    std::fill(portalBits.begin(), portalBits.end(), 0);
+}
+
+void CompactSearchState::setState(int x, int y, State s) {
+    size_t id = index(x, y);
+    setBit(openBits, id, (s & OPEN) != 0);
+    setBit(closedBits, id, (s & CLOSED) != 0);
+}
+
+void CompactSearchState::setParentDir(int x, int y, int dir) {
+    size_t id = index(x, y);
+    std::uint8_t shift = static_cast<std::uint8_t>((id & 3) * 2);
+    parentDirs[id >> 2] = static_cast<std::uint8_t>(
+        (parentDirs[id >> 2] & ~(3u << shift)) | ((dir & 3u) << shift));
+    setBit(hasParentBits, id, true);
+    setBit(portalBits, id, false);
+}
+
+void CompactSearchState::setParentPortal(int x, int y) {
+    size_t id = index(x, y);
+    setBit(hasParentBits, id, true);
+    setBit(portalBits, id, true);
+}
+
+void CompactSearchState::clearParent(int x, int y) {
+    size_t id = index(x, y);
+    setBit(hasParentBits, id, false);
+    setBit(portalBits, id, false);
+}
+
+int CompactSearchState::getParentDir(int x, int y) const {
+    size_t id = index(x, y);
+    if (!bit(hasParentBits, id) || bit(portalBits, id)) return -1;
+    return (parentDirs[id >> 2] >> ((id & 3) * 2)) & 3;
+}
+
+std::vector<Coord> CompactSearchState::tracePath(Coord to, const PortalSystem* portals) const {
+    std::vector<Coord> path;
+    if (!isReached(to.x, to.y)) return path;
+
+    Coord cur = to;
+    while (true) {
+        path.push_back(cur);
+        if (parentIsPortal(cur.x, cur.y)) {
+            if (!portals) break;
+            auto exit = portals->getPortalExit(cur);
+            if (!exit) break;
+            cur = *exit;
+            continue;
+        }
+
+        int dir = getParentDir(cur.x, cur.y);
+        if (dir < 0) break;  // origen
+        if (dir == 0) cur.y -= 1;
+        else if (dir == 1) cur.x -= 1;
+        else if (dir == 2) cur.x += 1;
+        else cur.y += 1;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<std::vector<float>> CompactSearchState::decodeDistanceGrid() const {
+    std::vector<std::vector<float>> grid(w, std::vector<float>(h, std::numeric_limits<float>::infinity()));
+    for (int x = 0; x < w; ++x) {
+        for (int y = 0; y < h; ++y) {
+            std::uint32_t d = getDistance(x, y);
+            if (d != UNREACHED) grid[x][y] = static_cast<float>(d);
+        }
+    }
+    return grid;
+}
+
+std::vector<std::vector<bool>> CompactSearchState::decodeReachedGrid() const {
+    std::vector<std::vector<bool>> grid(w, std::vector<bool>(h, false));
+    for (int x = 0; x < w; ++x)
+        for (int y = 0; y < h; ++y)
+            grid[x][y] = isReached(x, y);
+    return grid;
+}
+
+size_t CompactSearchState::bytesUsed() const {
+    return (openBits.size() + closedBits.size() + hasParentBits.size() + portalBits.size()) * sizeof(std::uint64_t)
+         + parentDirs.size()
+         + dist8.size() * sizeof(std::uint8_t)
+         + dist16.size() * sizeof(std::uint16_t)
+         + dist32.size() * sizeof(std::uint32_t);
+}
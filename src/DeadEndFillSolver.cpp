@@ -0,0 +1,176 @@
+#include "DeadEndFillSolver.h"
+#include <algorithm>
+#include <queue>
+
+DeadEndFillSolver::DeadEndFillSolver(const Grid &grid, Coord s, Coord g_)
+    : g(grid), start(s), goal(g_), w(grid.width()), h(grid.height()),
+      wordsPerRow((grid.width() + 63) / 64) {
+    PhaseTimer initTimer(stats.initTime);
+    size_t words = static_cast<size_t>(wordsPerRow) * h;
+    alive.assign(words, 0);
+    openRight.assign(words, 0);
+    openDown.assign(words, 0);
+    keep.assign(words, 0);
+    rowDirty.assign(h, 1);
+    deadScratch.assign(words, 0);
+
+    // Empaquetar las paredes una sola vez
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            setBit(alive, x, y);
+            const Cell &c = g.at(x, y);
+            if (x + 1 < w && !c.walls[2]) setBit(openRight, x, y);
+            if (y + 1 < h && !c.walls[3]) setBit(openDown, x, y);
+        }
+    }
+    setBit(keep, start.x, start.y);
+    setBit(keep, goal.x, goal.y);
+}
+
+bool DeadEndFillSolver::fillPass() {
+    // Fase 1: detectar callejones con el estado "alive" de la pasada anterior
+    std::vector<char> nextDirty(h, 0);
+    bool changed = false;
+
+    for (int y = 0; y < h; ++y) {
+        if (!rowDirty[y]) continue;
+
+        const std::uint64_t *al = row(alive, y);
+        const std::uint64_t *up = y > 0 ? row(alive, y - 1) : nullptr;
+        const std::uint64_t *down = y + 1 < h ? row(alive, y + 1) : nullptr;
+        const std::uint64_t *openR = row(openRight, y);
+        const std::uint64_t *openU = y > 0 ? row(openDown, y - 1) : nullptr;
+        const std::uint64_t *openD = row(openDown, y);
+        const std::uint64_t *kp = row(keep, y);
+        std::uint64_t *dead = row(deadScratch, y);
+
+        for (int i = 0; i < wordsPerRow; ++i) {
+            // Vecino derecho vivo: bit x de (alive >> 1), con acarreo de la palabra siguiente
+            std::uint64_t aliveRight = (al[i] >> 1) | (i + 1 < wordsPerRow ? al[i + 1] << 63 : 0);
+            // Vecino izquierdo: bit x de (alive << 1) y (openRight << 1)
+            std::uint64_t aliveLeft = (al[i] << 1) | (i > 0 ? al[i - 1] >> 63 : 0);
+            std::uint64_t openLeft = (openR[i] << 1) | (i > 0 ? openR[i - 1] >> 63 : 0);
+
+            std::uint64_t a = openR[i] & aliveRight;
+            std::uint64_t b = openLeft & aliveLeft;
+            std::uint64_t c = openU ? (openU[i] & up[i]) : 0;
+            std::uint64_t d = down ? (openD[i] & down[i]) : 0;
+
+            // Contador saturado de 2 planos: ones = >=1 vecino, twos = >=2 vecinos
+            std::uint64_t ones = a;
+            std::uint64_t twos = 0;
+            twos |= ones & b; ones |= b;
+            twos |= ones & c; ones |= c;
+            twos |= ones & d;
+
+            dead[i] = al[i] & ~twos & ~kp[i];
+            if (dead[i]) {
+                changed = true;
+                nextDirty[y] = 1;
+                if (y > 0) nextDirty[y - 1] = 1;
+                if (y + 1 < h) nextDirty[y + 1] = 1;
+            }
+        }
+    }
+
+    if (!changed) return false;
+
+    // Fase 2: aplicar las eliminaciones
+    for (int y = 0; y < h; ++y) {
+        if (!rowDirty[y]) continue;
+        std::uint64_t *al = row(alive, y);
+        std::uint64_t *dead = row(deadScratch, y);
+        for (int i = 0; i < wordsPerRow; ++i) {
+            if (!dead[i]) continue;
+            al[i] &= ~dead[i];
+            for (std::uint64_t bits = dead[i]; bits; bits &= bits - 1) ++filledCount;
+            dead[i] = 0;
+        }
+    }
+
+    rowDirty.swap(nextDirty);
+    return true;
+}
+
+void DeadEndFillSolver::walkCorridor() {
+    solution.clear();
+    if (!bit(alive, start.x, start.y) || !bit(alive, goal.x, goal.y)) return;
+
+    // En un laberinto perfecto queda un único corredor; si hay ciclos
+    // (laberintos imperfectos) el BFS sobre las celdas vivas toma el más corto
+    std::vector<int> parent(static_cast<size_t>(w) * h, -2);
+    std::queue<int> q;
+    int startId = start.y * w + start.x;
+    int goalId = goal.y * w + goal.x;
+    parent[startId] = -1;
+    q.push(startId);
+
+    while (!q.empty()) {
+        int cur = q.front();
+        q.pop();
+        if (cur == goalId) break;
+
+        int cx = cur % w, cy = cur / w;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (g.at(cx, cy).walls[dir]) continue;
+            int nx = cx, ny = cy;
+            if (dir == 0) ny -= 1;
+            else if (dir == 1) nx -= 1;
+            else if (dir == 2) nx += 1;
+            else if (dir == 3) ny += 1;
+
+            if (nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+            if (!bit(alive, nx, ny)) continue;
+            int nid = ny * w + nx;
+            if (parent[nid] != -2) continue;
+            parent[nid] = cur;
+            q.push(nid);
+        }
+    }
+
+    if (parent[goalId] == -2) return;  // Sin camino
+    for (int cur = goalId; cur != -1; cur = parent[cur]) {
+        solution.push_back(Coord(cur % w, cur / w));
+    }
+    std::reverse(solution.begin(), solution.end());
+}
+
+bool DeadEndFillSolver::step() {
+    if (done) return true;
+
+    if (filling) {
+        PhaseTimer searchTimer(stats.searchTime);
+        ++passes;
+        if (fillPass()) return false;
+        filling = false;
+    }
+
+    PhaseTimer pathTimer(stats.reconstructTime);
+    walkCorridor();
+    done = true;
+    return true;
+}
+
+bool DeadEndFillSolver::getCurrent(Coord &out) const {
+    // El relleno es global (no hay "celda actual"); mostrar el inicio
+    if (done) return false;
+    out = start;
+    return true;
+}
+
+SearchStats DeadEndFillSolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.pops = filledCount;
+    out.bytesAllocated = (alive.size() + openRight.size() + openDown.size() + keep.size()
+                          + deadScratch.size()) * sizeof(std::uint64_t)
+                       + rowDirty.size() + solution.size() * sizeof(Coord);
+    return out;
+}
+
+std::vector<std::vector<bool>> DeadEndFillSolver::getDeadEndMap() const {
+    std::vector<std::vector<bool>> map(w, std::vector<bool>(h, false));
+    for (int x = 0; x < w; ++x)
+        for (int y = 0; y < h; ++y)
+            map[x][y] = !bit(alive, x, y);
+    return map;
+}
@@ -1,55 +1,135 @@
 #include "ExplorationHeatmap.h"
-#include <numeric>
+#include "HeatmapColormap.h"
 
 ExplorationHeatmap::ExplorationHeatmap(int w, int h) 
     : width(w), height(h) {
-    // Reservar espacio para 400 celdas 
-    visitCounts.reserve(500);
+    initSlots(64);
 }
 
-void ExplorationHeatmap::recordVisit(int x, int y) {
+size_t ExplorationHeatmap::sparseLimit() const {
+    // Con carga <= 1/2 cada entrada usa >= 16 bytes de tabla; el arreglo denso
+    // usa 4 bytes por celda: a partir de 1/4 del grid el denso es más chico
+    return static_cast<size_t>(width) * height / 4;
+}
 
-    Coord key(x, y);
-    visitCounts[key]++;
-    
-    // Invalidar cache
-    cachedMaxVisits = -1;
+void ExplorationHeatmap::initSlots(size_t capacity) {
+    int bits = 1;
+    while ((size_t(1) << bits) < capacity) bits++;
+    slots.assign(size_t(1) << bits, Slot());
+    slotShift = 64 - bits;
 }
 
-int ExplorationHeatmap::getVisitCount(int x, int y) const {
+void ExplorationHeatmap::growSlots() {
+    std::vector<Slot> old;
+    old.swap(slots);
+    initSlots(old.size() * 2);
+    for (const Slot& s : old) {
+        if (s.key == EMPTY_KEY) continue;
+        size_t i = slotIndex(s.key);
+        const size_t mask = slots.size() - 1;
+        while (slots[i].key != EMPTY_KEY) i = (i + 1) & mask;
+        slots[i] = s;
+    }
+}
 
-    Coord key(x, y);
-    auto it = visitCounts.find(key);
-    
-    // Si no existe, retornar 0 (valor por defecto)
-    return (it != visitCounts.end()) ? it->second : 0;
+std::int32_t& ExplorationHeatmap::sparseCounter(std::uint32_t key) {
+    const size_t mask = slots.size() - 1;
+    size_t i = slotIndex(key);
+    while (slots[i].key != EMPTY_KEY) {
+        if (slots[i].key == key) return slots[i].count;
+        i = (i + 1) & mask;
+    }
+    slots[i].key = key;
+    slots[i].count = 0;
+    uniqueCells++;
+    return slots[i].count;
 }
 
-int ExplorationHeatmap::getMaxVisits() const {
-    // Cache para evitar recalcular
-    if (cachedMaxVisits >= 0) return cachedMaxVisits;
-    
-    if (visitCounts.empty()) {
-        cachedMaxVisits = 0;
-        return 0;
+void ExplorationHeatmap::switchToDense() {
+    denseCounts.assign(static_cast<size_t>(width) * height, 0);
+    for (const Slot& s : slots) {
+        if (s.key != EMPTY_KEY) denseCounts[s.key] = s.count;
     }
+    std::vector<Slot>().swap(slots);
+    dense = true;
+}
+
+void ExplorationHeatmap::recordVisits(int x, int y, int count) {
+    if (count <= 0 || x < 0 || y < 0 || x >= width || y >= height) return;
+    std::uint32_t key = static_cast<std::uint32_t>(y) * width + x;
 
-    int maxV = 0;
-    for (const auto& pair : visitCounts) {
-        maxV = std::max(maxV, pair.second);
+    std::int32_t* counter;
+    if (dense) {
+        counter = &denseCounts[key];
+        if (*counter == 0) uniqueCells++;
+    } else {
+        counter = &sparseCounter(key);
+    }
+
+    *counter += count;
+    totalVisits += count;
+    if (*counter > maxVisits) maxVisits = *counter;
+
+    if (pyramid) pyramid->add(x, y, static_cast<std::uint32_t>(count));
+
+    if (dirtyTracking) {
+        std::uint64_t bit = std::uint64_t(1) << (key & 63);
+        if (!(dirtyBits[key >> 6] & bit)) {
+            dirtyBits[key >> 6] |= bit;
+            dirtyCells.push_back(key);
+        }
+    }
+
+    if (!dense) {
+        if (static_cast<size_t>(uniqueCells) > sparseLimit()) {
+            switchToDense();
+        } else if (static_cast<size_t>(uniqueCells) * 2 > slots.size()) {
+            growSlots();
+        }
     }
-    
-    cachedMaxVisits = maxV;
-    return maxV;
 }
 
-int ExplorationHeatmap::getTotalCellsVisited() const {
-    return static_cast<int>(visitCounts.size());
+int ExplorationHeatmap::getVisitCount(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+    std::uint32_t key = static_cast<std::uint32_t>(y) * width + x;
+    if (dense) return denseCounts[key];
+
+    const size_t mask = slots.size() - 1;
+    for (size_t i = slotIndex(key); slots[i].key != EMPTY_KEY; i = (i + 1) & mask) {
+        if (slots[i].key == key) return slots[i].count;
+    }
+    // Si no existe, retornar 0 (valor por defecto)
+    return 0;
 }
 
 void ExplorationHeatmap::clear() {
-    visitCounts.clear();
-    cachedMaxVisits = -1;
+    dense = false;
+    std::vector<std::int32_t>().swap(denseCounts);
+    initSlots(64);
+    uniqueCells = 0;
+    totalVisits = 0;
+    maxVisits = 0;
+    dirtyCells.clear();
+    std::fill(dirtyBits.begin(), dirtyBits.end(), 0);
+    paintedMax = -1;
+    if (pyramid) pyramid->clear();
+}
+
+void ExplorationHeatmap::enableDirtyTracking() {
+    if (dirtyTracking) return;
+    dirtyTracking = true;
+    dirtyBits.assign((static_cast<size_t>(width) * height + 63) / 64, 0);
+    paintedMax = -1;  // Lo ya visitado entra en el primer pintado completo
+}
+
+void ExplorationHeatmap::enablePyramid() {
+    if (pyramid) return;
+    pyramid.emplace(width, height);
+    std::vector<std::uint32_t> counts(static_cast<size_t>(width) * height, 0);
+    forEachVisited([&](int x, int y, int visits) {
+        counts[static_cast<size_t>(y) * width + x] = static_cast<std::uint32_t>(visits);
+    });
+    pyramid->assign(counts);
 }
 
 std::vector<std::vector<float>> ExplorationHeatmap::toNormalizedGrid() const {
@@ -58,39 +138,74 @@ std::vector<std::vector<float>> ExplorationHeatmap::toNormalizedGrid() const {
         width, std::vector<float>(height, 0.0f)
     );
     
-    int maxV = getMaxVisits();
-    if (maxV == 0) return grid;
+    if (maxVisits == 0) return grid;
+    const float scale = 1.0f / maxVisits;
     
-    for (const auto& pair : visitCounts) {
-        const Coord& coord = pair.first;
-        int visits = pair.second;
-        
-        // Normalizar [0.0, 1.0]
-        grid[coord.x][coord.y] = static_cast<float>(visits) / maxV;
+    // Normalizar [0.0, 1.0]
+    if (dense) {
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                grid[x][y] = denseCounts[static_cast<size_t>(y) * width + x] * scale;
+    } else {
+        for (const Slot& s : slots) {
+            if (s.key == EMPTY_KEY) continue;
+            grid[s.key % width][s.key / width] = s.count * scale;
+        }
     }
     
     return grid;
 }
 
+int ExplorationHeatmap::writeRGBA(std::uint8_t* pixels, bool fullRepaint) const {
+    int written = 0;
+    
+    if (!dirtyTracking || fullRepaint || maxVisits != paintedMax) {
+        // Cambió la normalización: repintar todo
+        const size_t cells = static_cast<size_t>(width) * height;
+        if (dense) {
+            for (size_t id = 0; id < cells; ++id)
+                HeatmapColormap::writePixel(pixels, id, HeatmapColormap::indexFor(denseCounts[id], maxVisits));
+        } else {
+            for (size_t id = 0; id < cells; ++id) HeatmapColormap::writePixel(pixels, id, 0);
+            for (const Slot& s : slots) {
+                if (s.key == EMPTY_KEY) continue;
+                HeatmapColormap::writePixel(pixels, s.key, HeatmapColormap::indexFor(s.count, maxVisits));
+            }
+        }
+        written = static_cast<int>(cells);
+    } else {
+        for (std::uint32_t id : dirtyCells) {
+            int visits = getVisitCount(static_cast<int>(id % width), static_cast<int>(id / width));
+            HeatmapColormap::writePixel(pixels, id, HeatmapColormap::indexFor(visits, maxVisits));
+        }
+        written = static_cast<int>(dirtyCells.size());
+    }
+    
+    for (std::uint32_t id : dirtyCells) dirtyBits[id >> 6] &= ~(std::uint64_t(1) << (id & 63));
+    dirtyCells.clear();
+    paintedMax = maxVisits;
+    return written;
+}
+
 ExplorationHeatmap::HeatmapStats ExplorationHeatmap::getStats() const {
     HeatmapStats stats;
     
-    if (visitCounts.empty()) return stats;
-    
-    stats.uniqueCells = static_cast<int>(visitCounts.size());
-    stats.maxVisits = getMaxVisits();
+    if (uniqueCells == 0) return stats;
     
-    // Calcular total y promedio
-    int totalVisits = 0;
-    for (const auto& pair : visitCounts) {
-        totalVisits += pair.second;
-    }
+    stats.uniqueCells = uniqueCells;
+    stats.maxVisits = maxVisits;
     stats.totalVisits = totalVisits;
-    stats.avgVisits = static_cast<float>(totalVisits) / stats.uniqueCells;
+    stats.avgVisits = static_cast<float>(totalVisits) / uniqueCells;
     
     // Densidad (% del grid visitado)
     int totalCells = width * height;
-    stats.densityPercent = (static_cast<float>(stats.uniqueCells) / totalCells) * 100.0f;
+    stats.densityPercent = (static_cast<float>(uniqueCells) / totalCells) * 100.0f;
     
     return stats;
-}
\ No newline at end of file
+}
+
+size_t ExplorationHeatmap::bytesUsed() const {
+    return denseCounts.size() * sizeof(std::int32_t) + slots.size() * sizeof(Slot)
+         + dirtyBits.size() * sizeof(std::uint64_t) + dirtyCells.capacity() * sizeof(std::uint32_t)
+         + (pyramid ? pyramid->bytesUsed() : 0);
+}
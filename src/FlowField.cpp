@@ -0,0 +1,168 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+const int DX[4] = {0, -1, 1, 0};
+const int DY[4] = {-1, 0, 0, 1};
+}
+
+FlowField::FlowField(const Grid& grid, Coord goal_)
+    : g(grid), goal(goal_), w(grid.width()), h(grid.height()),
+      dist(static_cast<size_t>(w) * h, INF), dir(static_cast<size_t>(w) * h, -1) {
+    rebuild();
+}
+
+void FlowField::setGoal(Coord newGoal) {
+    goal = newGoal;
+    rebuild();
+}
+
+void FlowField::rebuild() {
+    std::fill(dist.begin(), dist.end(), INF);
+    std::fill(dir.begin(), dir.end(), -1);
+    if (!inBounds(goal.x, goal.y)) return;
+
+    std::vector<int> queue;
+    queue.reserve(dist.size());
+    int goalId = index(goal.x, goal.y);
+    dist[goalId] = 0;
+    queue.push_back(goalId);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cur = queue[head];
+        int cx = cur % w, cy = cur / w;
+        const Cell& cell = g.at(cx, cy);
+        for (int d = 0; d < 4; ++d) {
+            if (cell.walls[d]) continue;
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (!inBounds(nx, ny)) continue;
+            int nid = index(nx, ny);
+            if (dist[nid] != INF) continue;
+            dist[nid] = dist[cur] + 1;
+            dir[nid] = static_cast<std::int8_t>(3 - d);  // el vecino vuelve hacia cur
+            queue.push_back(nid);
+        }
+    }
+}
+
+int FlowField::update(const std::vector<Coord>& changedCells) {
+    if (!inBounds(goal.x, goal.y)) return 0;
+    const int goalId = index(goal.x, goal.y);
+
+    // 1) Invalidar: celdas cuyo paso hacia la meta quedó bloqueado, y todo su subárbol
+    std::vector<int> invalid;
+    std::vector<char> isInvalid(dist.size(), 0);
+    for (const Coord& c : changedCells) {
+        if (!inBounds(c.x, c.y)) continue;
+        int id = index(c.x, c.y);
+        int d = dir[id];
+        if (d >= 0 && g.at(c.x, c.y).walls[d] && !isInvalid[id]) {
+            isInvalid[id] = 1;
+            invalid.push_back(id);
+        }
+    }
+    for (size_t i = 0; i < invalid.size(); ++i) {
+        int cur = invalid[i];
+        int cx = cur % w, cy = cur / w;
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (!inBounds(nx, ny)) continue;
+            int nid = index(nx, ny);
+            // ¿El vecino apuntaba a cur?
+            if (!isInvalid[nid] && dir[nid] == 3 - d) {
+                isInvalid[nid] = 1;
+                invalid.push_back(nid);
+            }
+        }
+    }
+
+    std::vector<int> before;
+    before.reserve(invalid.size());
+    for (int id : invalid) {
+        before.push_back(dist[id]);
+        dist[id] = INF;
+        dir[id] = -1;
+    }
+
+    // 2) Sembrar: celdas invalidadas desde su mejor vecino válido,
+    //    y celdas cambiadas (posibles aristas nuevas) con su distancia actual
+    using Item = std::pair<int, int>;  // (distancia, celda)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+
+    for (int id : invalid) {
+        int cx = id % w, cy = id / w;
+        const Cell& cell = g.at(cx, cy);
+        for (int d = 0; d < 4; ++d) {
+            if (cell.walls[d]) continue;
+            int nx = cx + DX[d], ny = cy + DY[d];
+            if (!inBounds(nx, ny)) continue;
+            int nd = dist[index(nx, ny)];
+            if (nd != INF && nd + 1 < dist[id]) {
+                dist[id] = nd + 1;
+                dir[id] = static_cast<std::int8_t>(d);
+            }
+        }
+        if (dist[id] != INF) pq.push({dist[id], id});
+    }
+    for (const Coord& c : changedCells) {
+        if (!inBounds(c.x, c.y)) continue;
+        int id = index(c.x, c.y);
+        if (dist[id] != INF) pq.push({dist[id], id});
+    }
+
+    // 3) Propagar mejoras (Dijkstra con costo 1)
+    int changed = 0;
+    while (!pq.empty()) {
+        auto [d, cur] = pq.top();
+        pq.pop();
+        if (d > dist[cur]) continue;
+
+        int cx = cur % w, cy = cur / w;
+        const Cell& cell = g.at(cx, cy);
+        for (int k = 0; k < 4; ++k) {
+            if (cell.walls[k]) continue;
+            int nx = cx + DX[k], ny = cy + DY[k];
+            if (!inBounds(nx, ny)) continue;
+            int nid = index(nx, ny);
+            if (nid == goalId || d + 1 >= dist[nid]) continue;
+            if (!isInvalid[nid]) changed++;
+            dist[nid] = d + 1;
+            dir[nid] = static_cast<std::int8_t>(3 - k);
+            pq.push({dist[nid], nid});
+        }
+    }
+
+    for (size_t i = 0; i < invalid.size(); ++i) {
+        if (dist[invalid[i]] != before[i]) changed++;
+    }
+    return changed;
+}
+
+Coord FlowField::nextStep(Coord from) const {
+    if (!inBounds(from.x, from.y)) return from;
+    int d = dir[index(from.x, from.y)];
+    if (d < 0) return from;
+    return Coord(from.x + DX[d], from.y + DY[d]);
+}
+
+int FlowField::getMaxDistance() const {
+    int best = 0;
+    for (int d : dist)
+        if (d != INF && d > best) best = d;
+    return best;
+}
+
+std::vector<std::vector<float>> FlowField::toNormalizedGrid() const {
+    std::vector<std::vector<float>> grid(w, std::vector<float>(h, 0.0f));
+    float scale = 1.0f / static_cast<float>(getMaxDistance() + 1);
+    for (int x = 0; x < w; ++x) {
+        for (int y = 0; y < h; ++y) {
+            int d = dist[index(x, y)];
+            if (d != INF) grid[x][y] = static_cast<float>(d + 1) * scale;
+        }
+    }
+    return grid;
+}
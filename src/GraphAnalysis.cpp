@@ -1,4 +1,5 @@
 #include "GraphAnalysis.h"
+#include <algorithm>
 #include <limits>
 
 GraphAnalysis::GraphAnalysis(const Grid& grid) : g(grid) {}
@@ -3,18 +3,19 @@
 #include <algorithm>
 #include <limits>
 
-GreedySolver::GreedySolver(Grid &grid, Coord s, Coord g_)
+GreedySolver::GreedySolver(const Grid &grid, Coord s, Coord g_)
     : g(grid), start(s), goal(g_),
-      stateGrid(grid.width(), std::vector<CellState>(grid.height(), UNKNOWN)),
-      closed(grid.width(), std::vector<bool>(grid.height(), false)),
-      gScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      cameFrom(grid.width(), std::vector<Coord>(grid.height(), Coord(-1,-1))),
+      state(grid.width(), grid.height()),
       current(s) {
+    PhaseTimer initTimer(stats.initTime);
 
-    gScore[start.x][start.y] = 0.0f;
+    state.setDistance(start.x, start.y, 0);
+    state.clearParent(start.x, start.y);
+    state.setState(start.x, start.y, CompactSearchState::OPEN);
     float h = heuristic(start.x, start.y);
     openPQ.push({h, pushCounter++, start.x, start.y});
-    stateGrid[start.x][start.y] = OPEN;
+    stats.heuristicEvals++;
+    stats.notePush(openPQ.size());
 }
 
 float GreedySolver::heuristic(int x, int y) const {
@@ -24,22 +25,25 @@ float GreedySolver::heuristic(int x, int y) const {
 
 bool GreedySolver::step() {
     if (done) return true;
-    if (openPQ.empty()) { done = true; solved = false; return true; }
+    searchSpan.begin();
+    if (openPQ.empty()) { done = true; solved = false; searchSpan.end(stats.searchTime); return true; }
 
     PQNode node;
     do {
-        if (openPQ.empty()) { done = true; solved = false; return true; }
+        if (openPQ.empty()) { done = true; solved = false; searchSpan.end(stats.searchTime); return true; }
         node = openPQ.top();
         openPQ.pop();
-    } while (closed[node.x][node.y]);
+        if (state.isClosed(node.x, node.y)) stats.stalePops++;
+    } while (state.isClosed(node.x, node.y));
+    stats.pops++;
 
     int cx = node.x, cy = node.y;
     current = Coord(cx, cy);
 
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
+    state.setState(cx, cy, CompactSearchState::CLOSED);
 
     if (cx == goal.x && cy == goal.y) {
+        searchSpan.end(stats.searchTime);
         reconstruct_path(cx, cy);
         done = true;
         solved = true;
@@ -56,16 +60,19 @@ bool GreedySolver::step() {
         else if (dir == 3) ny += 1;
 
         if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
+        if (state.isClosed(nx, ny)) continue;
 
-        float tentative_g = gScore[cx][cy] + 1.0f;
+        std::uint32_t tentative_g = state.getDistance(cx, cy) + 1;
 
-        if (tentative_g < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_g;
+        if (tentative_g < state.getDistance(nx, ny)) {
+            if (state.isReached(nx, ny)) stats.reopenings++;
+            state.setParentDir(nx, ny, CompactSearchState::oppositeDir(dir));
+            state.setState(nx, ny, CompactSearchState::OPEN);
+            state.setDistance(nx, ny, tentative_g);
             float h = heuristic(nx, ny);
             openPQ.push({h, pushCounter++, nx, ny});
-            stateGrid[nx][ny] = OPEN;
+            stats.heuristicEvals++;
+            stats.notePush(openPQ.size());
         }
     }
 
@@ -73,13 +80,8 @@ bool GreedySolver::step() {
 }
 
 void GreedySolver::reconstruct_path(int x, int y) {
-    solution.clear();
-    Coord cur(x, y);
-    while (!(cur.x == -1 && cur.y == -1)) {
-        solution.push_back(cur);
-        cur = cameFrom[cur.x][cur.y];
-    }
-    std::reverse(solution.begin(), solution.end());
+    PhaseTimer pathTimer(stats.reconstructTime);
+    solution = state.tracePath(Coord(x, y));
 }
 
 bool GreedySolver::finished() const { return done; }
@@ -91,3 +93,10 @@ bool GreedySolver::getCurrent(Coord &out) const {
 }
 
 const std::vector<Coord> &GreedySolver::getSolution() const { return solution; }
+
+SearchStats GreedySolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.bytesAllocated = state.bytesUsed() + static_cast<size_t>(stats.peakOpen) * sizeof(PQNode)
+                       + solution.size() * sizeof(Coord);
+    return out;
+}
@@ -1,8 +1,21 @@
 #include "Grid.h"
 #include <cstdlib>
 
+namespace {
+// splitmix64: mezcla barata para derivar claves Zobrist sin tabla
+std::uint64_t mix64(std::uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
 Grid::Grid(int width, int height) : m_width(width), m_height(height) {
     m_grid.resize(m_height, std::vector<Cell>(m_width));
+    m_wallHash = emptyHash();
+    m_hLineVersion.assign(m_height + 1, 0);
+    m_vLineVersion.assign(m_width + 1, 0);
 }
 
 int Grid::width() const { return m_width; }
@@ -18,11 +31,30 @@ bool Grid::removeWall(int row, int column, short wall) {
     if (wall == 2 && column == m_width - 1) return false;
     if (wall == 3 && row == m_height - 1) return false;
 
+    if (m_grid[row][column].walls[wall]) {
+        if (wall == 0) m_wallHash ^= edgeKey(column, row - 1, 1);
+        else if (wall == 1) m_wallHash ^= edgeKey(column - 1, row, 0);
+        else if (wall == 2) m_wallHash ^= edgeKey(column, row, 0);
+        else if (wall == 3) m_wallHash ^= edgeKey(column, row, 1);
+
+        m_openPassages++;
+
+        if (wall == 0 || wall == 3) m_hLineVersion[row + (wall == 3)]++;
+        else m_vLineVersion[column + (wall == 2)]++;
+        m_wallVersion++;
+    }
+
     m_grid[row][column].walls[wall] = false;
-    if (wall == 0) m_grid[row - 1][column].walls[3] = false;
-    else if (wall == 1) m_grid[row][column - 1].walls[2] = false;
-    else if (wall == 2) m_grid[row][column + 1].walls[1] = false;
-    else if (wall == 3) m_grid[row + 1][column].walls[0] = false;
+    int nx = column, ny = row;
+    if (wall == 0) m_grid[--ny][column].walls[3] = false;
+    else if (wall == 1) m_grid[row][--nx].walls[2] = false;
+    else if (wall == 2) m_grid[row][++nx].walls[1] = false;
+    else if (wall == 3) m_grid[++ny][column].walls[0] = false;
+
+    if (m_wallPyramid) {
+        m_wallPyramid->set(column, row, wallCount(column, row));
+        m_wallPyramid->set(nx, ny, wallCount(nx, ny));
+    }
     return true;
 }
 
@@ -40,3 +72,65 @@ bool Grid::canMove(int x, int y, int dir) const {
     const Cell &cell = at(x, y);
     return !cell.walls[dir];
 };
+
+std::uint64_t Grid::emptyHash() const {
+    return mix64((static_cast<std::uint64_t>(m_width) << 32) | static_cast<std::uint32_t>(m_height));
+}
+
+std::uint64_t Grid::edgeKey(int x, int y, int axis) const {
+    std::uint64_t id = (static_cast<std::uint64_t>(y) * m_width + x) * 2 + axis;
+    return mix64(id ^ 0xD6E8FEB86659FD93ULL);
+}
+
+void Grid::resetWalls() {
+    for (auto &row : m_grid)
+        for (auto &cell : row)
+            for (bool &w : cell.walls) w = true;
+    m_wallHash = emptyHash();
+    m_openPassages = 0;
+    if (m_wallPyramid) rebuildWallPyramid();
+    touchAllWallLines();
+}
+
+void Grid::rehashWalls() {
+    m_wallHash = emptyHash();
+    m_openPassages = 0;
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            if (x + 1 < m_width && !m_grid[y][x].walls[2]) {
+                m_wallHash ^= edgeKey(x, y, 0);
+                m_openPassages++;
+            }
+            if (y + 1 < m_height && !m_grid[y][x].walls[3]) {
+                m_wallHash ^= edgeKey(x, y, 1);
+                m_openPassages++;
+            }
+        }
+    }
+    if (m_wallPyramid) rebuildWallPyramid();
+    touchAllWallLines();
+}
+
+void Grid::touchAllWallLines() {
+    for (std::uint32_t &v : m_hLineVersion) v++;
+    for (std::uint32_t &v : m_vLineVersion) v++;
+    m_wallVersion++;
+}
+
+std::uint32_t Grid::wallCount(int x, int y) const {
+    const Cell &cell = m_grid[y][x];
+    return static_cast<std::uint32_t>(cell.walls[0] + cell.walls[1] + cell.walls[2] + cell.walls[3]);
+}
+
+void Grid::enableWallPyramid() {
+    if (!m_wallPyramid) m_wallPyramid.emplace(m_width, m_height);
+    rebuildWallPyramid();
+}
+
+void Grid::rebuildWallPyramid() {
+    std::vector<std::uint32_t> counts(static_cast<size_t>(m_width) * m_height);
+    for (int y = 0; y < m_height; ++y)
+        for (int x = 0; x < m_width; ++x)
+            counts[static_cast<size_t>(y) * m_width + x] = wallCount(x, y);
+    m_wallPyramid->assign(counts);
+}
@@ -0,0 +1,117 @@
+#include "HeatmapAggregator.h"
+#include "ExplorationHeatmap.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+const char MAGIC[4] = {'M', 'Z', 'H', 'M'};
+const std::uint32_t FORMAT_VERSION = 1;
+}
+
+void HeatmapAggregator::Shard::add(const ExplorationHeatmap& heatmap) {
+    heatmap.forEachVisited([this](int x, int y, int visits) {
+        add(x, y, static_cast<std::uint64_t>(visits));
+    });
+    runs++;
+}
+
+HeatmapAggregator::HeatmapAggregator(int w, int h, int shardCount)
+    : width(w), height(h),
+      shards(std::max(1, shardCount)),
+      totals(static_cast<size_t>(w) * h, 0) {
+    for (Shard& s : shards) {
+        s.counts.assign(totals.size(), 0);
+        s.width = width;
+    }
+}
+
+void HeatmapAggregator::merge() {
+    for (Shard& s : shards) {
+        for (size_t i = 0; i < totals.size(); ++i) totals[i] += s.counts[i];
+        runs += s.runs;
+        std::fill(s.counts.begin(), s.counts.end(), 0);
+        s.runs = 0;
+    }
+}
+
+bool HeatmapAggregator::mergeFrom(const HeatmapAggregator& other) {
+    if (other.width != width || other.height != height) return false;
+    for (size_t i = 0; i < totals.size(); ++i) totals[i] += other.totals[i];
+    runs += other.runs;
+    return true;
+}
+
+void HeatmapAggregator::clear() {
+    std::fill(totals.begin(), totals.end(), 0);
+    runs = 0;
+    for (Shard& s : shards) {
+        std::fill(s.counts.begin(), s.counts.end(), 0);
+        s.runs = 0;
+    }
+}
+
+std::uint64_t HeatmapAggregator::getMaxVisits() const {
+    std::uint64_t best = 0;
+    for (std::uint64_t v : totals) best = std::max(best, v);
+    return best;
+}
+
+std::uint64_t HeatmapAggregator::getTotalVisits() const {
+    std::uint64_t sum = 0;
+    for (std::uint64_t v : totals) sum += v;
+    return sum;
+}
+
+std::vector<std::vector<float>> HeatmapAggregator::toNormalizedGrid() const {
+    std::vector<std::vector<float>> grid(width, std::vector<float>(height, 0.0f));
+    std::uint64_t maxV = getMaxVisits();
+    if (maxV == 0) return grid;
+
+    const double scale = 1.0 / static_cast<double>(maxV);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            grid[x][y] = static_cast<float>(totals[static_cast<size_t>(y) * width + x] * scale);
+    return grid;
+}
+
+bool HeatmapAggregator::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    std::uint32_t w = static_cast<std::uint32_t>(width);
+    std::uint32_t h = static_cast<std::uint32_t>(height);
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&w), sizeof(w));
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(&runs), sizeof(runs));
+    out.write(reinterpret_cast<const char*>(totals.data()),
+              static_cast<std::streamsize>(totals.size() * sizeof(std::uint64_t)));
+    return static_cast<bool>(out);
+}
+
+bool HeatmapAggregator::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    std::uint32_t version = 0, w = 0, h = 0;
+    std::uint64_t fileRuns = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&w), sizeof(w));
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    in.read(reinterpret_cast<char*>(&fileRuns), sizeof(fileRuns));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != FORMAT_VERSION) return false;
+    if (static_cast<int>(w) != width || static_cast<int>(h) != height) return false;
+
+    std::vector<std::uint64_t> loaded(totals.size());
+    in.read(reinterpret_cast<char*>(loaded.data()),
+            static_cast<std::streamsize>(loaded.size() * sizeof(std::uint64_t)));
+    if (!in) return false;
+
+    totals.swap(loaded);
+    runs = fileRuns;
+    return true;
+}
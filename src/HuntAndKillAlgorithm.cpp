@@ -1,22 +1,12 @@
-#include "MazeAlgorithm.h"
+#include "CoroutineMazeAlgorithm.h"
 #include <vector>
 #include <cstdlib>
 #include <ctime>
 
-struct HuntAndKillAlgorithm : public MazeAlgorithm {
-    Grid &g;
-    int cx = 0, cy = 0;
-    bool done = false;
-    bool hunting = false;
+struct HuntAndKillAlgorithm : public CoroutineMazeAlgorithm {
+    HuntAndKillAlgorithm(Grid &grid) : CoroutineMazeAlgorithm(generate(grid)) {}
 
-    HuntAndKillAlgorithm(Grid &grid) : g(grid) {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        cx = std::rand() % g.width();
-        cy = std::rand() % g.height();
-        g.at(cx, cy).visited = true;
-    }
-
-    int pickRandomUnvisitedNeighborDir(int x, int y) const {
+    static int pickRandomUnvisitedNeighborDir(const Grid &g, int x, int y) {
         std::vector<int> dirs;
         if (y > 0 && !g.at(x, y - 1).visited) dirs.push_back(0);
         if (x > 0 && !g.at(x - 1, y).visited) dirs.push_back(1);
@@ -26,7 +16,7 @@ struct HuntAndKillAlgorithm : public MazeAlgorithm {
         return dirs[std::rand() % dirs.size()];
     }
 
-    int pickRandomVisitedNeighborDir(int x, int y) const {
+    static int pickRandomVisitedNeighborDir(const Grid &g, int x, int y) {
         std::vector<int> dirs;
         if (y > 0 && g.at(x, y - 1).visited) dirs.push_back(0);
         if (x > 0 && g.at(x - 1, y).visited) dirs.push_back(1);
@@ -36,21 +26,19 @@ struct HuntAndKillAlgorithm : public MazeAlgorithm {
         return dirs[std::rand() % dirs.size()];
     }
 
-    bool allVisited() const {
-        for (int y = 0; y < g.height(); ++y)
-            for (int x = 0; x < g.width(); ++x)
-                if (!g.at(x, y).visited)
-                    return false;
-        return true;
-    }
-
-    bool step() override {
-        if (done) return true;
+    // El flag "hunting" desaparece: la fase en curso es el punto del código
+    // donde quedó suspendida la corrutina
+    static Generator<Coord> generate(Grid &g) {
+        std::srand(static_cast<unsigned>(std::time(nullptr)));
+        int cx = std::rand() % g.width();
+        int cy = std::rand() % g.height();
+        g.at(cx, cy).visited = true;
+        co_yield Coord(cx, cy);
 
-        // === Kill phase (random walk) ===
-        if (!hunting) {
-            int dir = pickRandomUnvisitedNeighborDir(cx, cy);
-            if (dir != -1) {
+        while (true) {
+            // === Kill phase (random walk) ===
+            int dir;
+            while ((dir = pickRandomUnvisitedNeighborDir(g, cx, cy)) != -1) {
                 int nx = cx, ny = cy;
                 if (dir == 0) ny--;
                 else if (dir == 1) nx--;
@@ -60,40 +48,27 @@ struct HuntAndKillAlgorithm : public MazeAlgorithm {
                 g.removeWall(cy, cx, static_cast<short>(dir));
                 g.at(nx, ny).visited = true;
                 cx = nx; cy = ny;
-                return false;
-            } else {
-                // no unvisited neighbors, start hunting
-                hunting = true;
-                return false;
+                co_yield Coord(cx, cy);
             }
-        }
 
-        // === Hunt phase (find next unvisited with visited neighbor) ===
-        for (int y = 0; y < g.height(); ++y) {
-            for (int x = 0; x < g.width(); ++x) {
-                if (!g.at(x, y).visited) {
-                    int vdir = pickRandomVisitedNeighborDir(x, y);
-                    if (vdir != -1) {
-                        g.removeWall(y, x, static_cast<short>(vdir));
-                        g.at(x, y).visited = true;
-                        cx = x; cy = y;
-                        hunting = false;
-                        return false;
-                    }
+            // === Hunt phase (find next unvisited with visited neighbor) ===
+            bool found = false;
+            for (int y = 0; y < g.height() && !found; ++y) {
+                for (int x = 0; x < g.width() && !found; ++x) {
+                    if (g.at(x, y).visited) continue;
+                    int vdir = pickRandomVisitedNeighborDir(g, x, y);
+                    if (vdir == -1) continue;
+
+                    g.removeWall(y, x, static_cast<short>(vdir));
+                    g.at(x, y).visited = true;
+                    cx = x; cy = y;
+                    found = true;
                 }
             }
-        }
 
-        // If no cell found — maze complete
-        done = true;
-        return true;
-    }
-
-    bool finished() const override { return done; }
-
-    bool getCurrent(Coord &out) const override {
-        if (done) return false;
-        out = Coord(cx, cy);
-        return true;
+            // If no cell found — maze complete
+            if (!found) co_return;
+            co_yield Coord(cx, cy);
+        }
     }
 };
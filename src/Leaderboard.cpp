@@ -0,0 +1,419 @@
+#include "Leaderboard.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char LOG_MAGIC[4] = {'M', 'Z', 'L', 'L'};
+const char SNAP_MAGIC[4] = {'M', 'Z', 'L', 'S'};
+const std::uint32_t FORMAT_VERSION = 1;
+const size_t LOG_HEADER_BYTES = sizeof(LOG_MAGIC) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+// Archivo de solo lectura mapeado en memoria (sin mmap: se lee entero)
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mapped = static_cast<const char*>(p);
+                length = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return;
+        fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        mapped = fallback.data();
+        length = fallback.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapped) ::munmap(const_cast<char*>(mapped), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return mapped; }
+    size_t size() const { return length; }
+
+private:
+    const char* mapped = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> fallback;
+#endif
+};
+
+// Lectura con chequeo de límites sobre un buffer
+struct Reader {
+    const char* pos;
+    const char* end;
+
+    template <typename T>
+    bool get(T& value) {
+        if (static_cast<size_t>(end - pos) < sizeof(T)) return false;
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool getName(std::string& name) {
+        std::uint16_t len = 0;
+        if (!get(len) || static_cast<size_t>(end - pos) < len) return false;
+        name.assign(pos, len);
+        pos += len;
+        return true;
+    }
+};
+
+template <typename T>
+void put(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void putName(std::ostream& out, const std::string& name) {
+    std::uint16_t len = static_cast<std::uint16_t>(std::min<size_t>(name.size(), 0xffff));
+    put(out, len);
+    out.write(name.data(), len);
+}
+
+}  // namespace
+
+
+AlgorithmStats Leaderboard::Totals::averaged(const std::string& name) const {
+    AlgorithmStats avg;
+    avg.algorithmName = name;
+    if (runs == 0) return avg;
+
+    // Redondeo (no truncado) de las medias enteras
+    double n = static_cast<double>(runs);
+    avg.nodesExpanded = static_cast<int>(std::llround(nodesExpanded / n));
+    avg.pathLength = static_cast<int>(std::llround(pathLength / n));
+    avg.executionTime = static_cast<float>(executionTime / n);
+    avg.treasuresCollected = static_cast<int>(std::llround(treasuresCollected / n));
+    return avg;
+}
+
+Leaderboard::Leaderboard(std::string basePath)
+    : logPath(basePath + ".log"), snapPath(basePath + ".snap"),
+      published(new PublishedNode{std::make_shared<const LeaderboardSnapshot>()}) {}
+
+Leaderboard::~Leaderboard() {
+    stopWriter();
+    if (log.is_open()) log.flush();
+
+    // Sin lectores activos: liberar la publicación, lo retirado y los registros
+    delete published.load();
+    for (PublishedNode* node : retired) delete node;
+    for (HazardRecord* r = hazardRecords.load(); r;) {
+        HazardRecord* next = r->next;
+        delete r;
+        r = next;
+    }
+}
+
+bool Leaderboard::open() {
+    totals.clear();
+    ranking.clear();
+    generation = 0;
+    logRuns = 0;
+    totalRuns = 0;
+
+    loadSnapshot();
+    replayLog();
+
+    for (const auto& [name, t] : totals) ranking.insert(t.averaged(name));
+    publish();
+    return log.is_open();
+}
+
+bool Leaderboard::loadSnapshot() {
+    MappedFile file(snapPath);
+    if (!file.data()) return false;
+
+    Reader in{file.data(), file.data() + file.size()};
+    char magic[4];
+    std::uint32_t version = 0, entryCount = 0;
+    std::uint64_t fileGeneration = 0;
+    if (!in.get(magic) || std::memcmp(magic, SNAP_MAGIC, sizeof(SNAP_MAGIC)) != 0) return false;
+    if (!in.get(version) || version != FORMAT_VERSION) return false;
+    if (!in.get(fileGeneration) || !in.get(entryCount)) return false;
+
+    std::unordered_map<std::string, Totals> loaded;
+    std::uint64_t loadedRuns = 0;
+    for (std::uint32_t i = 0; i < entryCount; ++i) {
+        std::string name;
+        Totals t;
+        if (!in.getName(name) || !in.get(t.runs) || !in.get(t.nodesExpanded) || !in.get(t.pathLength) ||
+            !in.get(t.executionTime) || !in.get(t.treasuresCollected)) {
+            return false;  // Snapshot corrupto: se ignora entero
+        }
+        loadedRuns += t.runs;
+        loaded[name] = t;
+    }
+
+    totals.swap(loaded);
+    totalRuns = loadedRuns;
+    generation = fileGeneration;
+    return true;
+}
+
+void Leaderboard::replayLog() {
+    size_t validBytes = 0;
+    bool usable = false;
+    {
+        MappedFile file(logPath);
+        if (file.data() && file.size() >= LOG_HEADER_BYTES) {
+            Reader in{file.data(), file.data() + file.size()};
+            char magic[4];
+            std::uint32_t version = 0;
+            std::uint64_t logGeneration = 0;
+            in.get(magic);
+            in.get(version);
+            in.get(logGeneration);
+
+            // Un log de una generación anterior ya está incluido en el snapshot
+            usable = std::memcmp(magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 &&
+                     version == FORMAT_VERSION && logGeneration >= generation;
+            if (usable) {
+                generation = logGeneration;
+                validBytes = LOG_HEADER_BYTES;
+                while (in.pos < in.end) {
+                    AlgorithmStats run;
+                    if (!in.getName(run.algorithmName) || !in.get(run.nodesExpanded) || !in.get(run.pathLength) ||
+                        !in.get(run.executionTime) || !in.get(run.treasuresCollected)) {
+                        break;  // Registro cortado: se descarta
+                    }
+                    apply(run);
+                    logRuns++;
+                    validBytes = static_cast<size_t>(in.pos - file.data());
+                }
+            }
+        }
+    }
+
+    if (!usable) {
+        resetLog();
+        return;
+    }
+
+    std::error_code ec;
+    if (std::filesystem::file_size(logPath, ec) != validBytes && !ec) {
+        std::filesystem::resize_file(logPath, validBytes, ec);
+    }
+    log.open(logPath, std::ios::binary | std::ios::app);
+}
+
+bool Leaderboard::resetLog() {
+    if (log.is_open()) log.close();
+    log.open(logPath, std::ios::binary | std::ios::trunc);
+    if (!log) return false;
+
+    log.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+    put(log, FORMAT_VERSION);
+    put(log, generation);
+    log.flush();
+    logRuns = 0;
+    return static_cast<bool>(log);
+}
+
+void Leaderboard::apply(const AlgorithmStats& run) {
+    Totals& t = totals[run.algorithmName];
+    t.runs++;
+    t.nodesExpanded += run.nodesExpanded;
+    t.pathLength += run.pathLength;
+    t.executionTime += run.executionTime;
+    t.treasuresCollected += run.treasuresCollected;
+    totalRuns++;
+}
+
+void Leaderboard::appendToLog(const AlgorithmStats& run) {
+    if (!log.is_open()) return;
+    putName(log, run.algorithmName);
+    put(log, run.nodesExpanded);
+    put(log, run.pathLength);
+    put(log, run.executionTime);
+    put(log, run.treasuresCollected);
+    logRuns++;
+}
+
+void Leaderboard::record(const AlgorithmStats& run) {
+    apply(run);
+    ranking.insert(totals[run.algorithmName].averaged(run.algorithmName));
+    appendToLog(run);
+
+    if (compactEvery > 0 && logRuns >= compactEvery) compact();
+}
+
+void Leaderboard::publish() {
+    auto snap = std::make_shared<LeaderboardSnapshot>();
+    std::vector<RankEntry> ranked = ranking.getAll();
+    snap->entries.reserve(ranked.size());
+    for (const RankEntry& r : ranked) {
+        LeaderboardEntry entry;
+        entry.stats = r.stats;
+        entry.runs = totals[r.stats.algorithmName].runs;
+        entry.rank = r.rank;
+        snap->entries.push_back(std::move(entry));
+    }
+    snap->totalRuns = totalRuns;
+    snap->version = ++publishCount;
+
+    PublishedNode* old = published.exchange(new PublishedNode{std::move(snap)});
+    retired.push_back(old);
+    reclaimRetired();
+}
+
+std::shared_ptr<const LeaderboardSnapshot> Leaderboard::snapshot() const {
+    HazardRecord* rec = acquireHazard();
+
+    // Anunciar el nodo y revalidar: si 'published' no cambió después del
+    // anuncio, el escritor ve el hazard antes de poder borrarlo
+    PublishedNode* node = published.load();
+    while (true) {
+        rec->hazard.store(node);
+        PublishedNode* current = published.load();
+        if (current == node) break;
+        node = current;
+    }
+
+    std::shared_ptr<const LeaderboardSnapshot> snap = node->snap;
+    rec->hazard.store(nullptr, std::memory_order_release);
+    rec->active.store(false, std::memory_order_release);
+    return snap;
+}
+
+Leaderboard::HazardRecord* Leaderboard::acquireHazard() const {
+    for (HazardRecord* r = hazardRecords.load(std::memory_order_acquire); r; r = r->next) {
+        bool expected = false;
+        if (!r->active.load(std::memory_order_relaxed) &&
+            r->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return r;
+        }
+    }
+
+    // Todos ocupados: agregar uno al frente de la lista (solo crece)
+    HazardRecord* r = new HazardRecord;
+    r->active.store(true, std::memory_order_relaxed);
+    HazardRecord* head = hazardRecords.load(std::memory_order_relaxed);
+    do {
+        r->next = head;
+    } while (!hazardRecords.compare_exchange_weak(head, r));
+    return r;
+}
+
+void Leaderboard::reclaimRetired() {
+    // seq_cst (como el anuncio del lector): un registro que no llegue a verse
+    // acá se agregó después del exchange y su lector revalida contra el nodo nuevo
+    std::vector<PublishedNode*> announced;
+    for (HazardRecord* r = hazardRecords.load(); r; r = r->next) {
+        if (PublishedNode* p = r->hazard.load()) announced.push_back(p);
+    }
+
+    // Lo que nadie anunció ya no es alcanzable: como mucho un nodo por lector queda retenido
+    size_t kept = 0;
+    for (PublishedNode* node : retired) {
+        if (std::find(announced.begin(), announced.end(), node) != announced.end()) {
+            retired[kept++] = node;
+        } else {
+            delete node;
+        }
+    }
+    retired.resize(kept);
+}
+
+bool Leaderboard::compact() {
+    std::string tmpPath = snapPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        out.write(SNAP_MAGIC, sizeof(SNAP_MAGIC));
+        put(out, FORMAT_VERSION);
+        put(out, generation + 1);
+        put(out, static_cast<std::uint32_t>(totals.size()));
+        for (const auto& [name, t] : totals) {
+            putName(out, name);
+            put(out, t.runs);
+            put(out, t.nodesExpanded);
+            put(out, t.pathLength);
+            put(out, t.executionTime);
+            put(out, t.treasuresCollected);
+        }
+        out.flush();
+        if (!out) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, snapPath, ec);
+    if (ec) return false;
+
+    // Desde acá el log viejo queda obsoleto (generación menor)
+    generation++;
+    return resetLog();
+}
+
+void Leaderboard::startWriter() {
+    if (writer.joinable()) return;
+    stopRequested = false;
+    writer = std::thread(&Leaderboard::writerLoop, this);
+}
+
+void Leaderboard::submit(const AlgorithmStats& run) {
+    if (!writer.joinable()) {
+        record(run);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(run);
+    }
+    queueReady.notify_one();
+}
+
+void Leaderboard::stopWriter() {
+    if (!writer.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopRequested = true;
+    }
+    queueReady.notify_one();
+    writer.join();
+}
+
+void Leaderboard::writerLoop() {
+    std::vector<AlgorithmStats> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopRequested || !queue.empty(); });
+            batch.swap(queue);
+            if (batch.empty() && stopRequested) break;
+        }
+
+        for (const AlgorithmStats& run : batch) record(run);
+        batch.clear();
+
+        if (log.is_open()) log.flush();
+        publish();
+    }
+}
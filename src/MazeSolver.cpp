@@ -1,26 +1,28 @@
 #include "MazeSolver.h"
-#include <algorithm>
 
-MazeSolver::MazeSolver(Grid &grid, Coord s, Coord g)
-    : g(grid), start(s), goal(g), visited(grid.width(), std::vector<bool>(grid.height(), false)),
-      cameFrom(grid.width(), std::vector<Coord>(grid.height(), Coord(-1, -1))) {
+MazeSolver::MazeSolver(const Grid &grid, Coord s, Coord g)
+    : g(grid), start(s), goal(g), state(grid.width(), grid.height()) {
+    PhaseTimer initTimer(stats.initTime);
     path.push(start);
-    visited[start.x][start.y] = true;
+    stats.notePush(path.size());
+    state.setState(start.x, start.y, CompactSearchState::OPEN);
+    state.clearParent(start.x, start.y);
 }
 
 bool MazeSolver::step() {
-    if (solved || path.empty()) return true;
+    if (solved || path.empty()) {
+        searchSpan.end(stats.searchTime);  // Sin camino: la pila se vació en el paso anterior
+        return true;
+    }
+    searchSpan.begin();
 
     Coord cur = path.top();
 
     if (cur.x == goal.x && cur.y == goal.y) {
         // reconstruir el camino
-        Coord step = goal;
-        while (!(step.x == -1 && step.y == -1)) {
-            solution.push_back(step);
-            step = cameFrom[step.x][step.y];
-        }
-        std::reverse(solution.begin(), solution.end());
+        searchSpan.end(stats.searchTime);
+        PhaseTimer pathTimer(stats.reconstructTime);
+        solution = state.tracePath(goal);
         solved = true;
         return true;
     }
@@ -34,16 +36,18 @@ bool MazeSolver::step() {
             else if (dir == 3) ny += 1;
 
             if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-            if (visited[nx][ny]) continue;
+            if (state.isReached(nx, ny)) continue;
 
-            visited[nx][ny] = true;
-            cameFrom[nx][ny] = cur;
+            state.setState(nx, ny, CompactSearchState::OPEN);
+            state.setParentDir(nx, ny, CompactSearchState::oppositeDir(dir));
             path.push(Coord(nx, ny));
+            stats.notePush(path.size());
             return false;
         }
     }
 
     path.pop(); // retrocede si no hay salida
+    stats.pops++;
     return false;
 }
 
@@ -61,4 +65,11 @@ const std::vector<Coord> &MazeSolver::getSolution() const {
     return solution;
 }
 
+SearchStats MazeSolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.bytesAllocated = state.bytesUsed() + static_cast<size_t>(stats.peakOpen) * sizeof(Coord)
+                       + solution.size() * sizeof(Coord);
+    return out;
+}
+
 
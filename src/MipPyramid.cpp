@@ -0,0 +1,138 @@
+#include "MipPyramid.h"
+#include "HeatmapColormap.h"
+#include <algorithm>
+
+MipPyramid::MipPyramid(int width, int height)
+    : w(width), h(height), base(static_cast<size_t>(width) * height, 0) {
+    Level top;
+    top.width = w;
+    top.height = h;
+    levels.push_back(top);
+    while (top.width > 1 || top.height > 1) {
+        top.width = (top.width + 1) / 2;
+        top.height = (top.height + 1) / 2;
+        top.sums.assign(static_cast<size_t>(top.width) * top.height, 0);
+        top.maxes.assign(top.sums.size(), 0);
+        levels.push_back(top);
+    }
+}
+
+std::uint64_t MipPyramid::getSum(int level, int x, int y) const {
+    if (level == 0) return base[index0(x, y)];
+    return levels[level].sums[indexOf(level, x, y)];
+}
+
+std::uint32_t MipPyramid::getMax(int level, int x, int y) const {
+    if (level == 0) return base[index0(x, y)];
+    return levels[level].maxes[indexOf(level, x, y)];
+}
+
+std::uint32_t MipPyramid::childMax(int level, int x, int y) const {
+    const int cw = levels[level - 1].width, ch = levels[level - 1].height;
+    const int x0 = x * 2, y0 = y * 2;
+    std::uint32_t best = 0;
+    for (int cy = y0; cy < std::min(y0 + 2, ch); ++cy)
+        for (int cx = x0; cx < std::min(x0 + 2, cw); ++cx)
+            best = std::max(best, getMax(level - 1, cx, cy));
+    return best;
+}
+
+void MipPyramid::add(int x, int y, std::uint32_t delta) {
+    std::uint32_t value = (base[index0(x, y)] += delta);
+    for (int l = 1; l < getLevelCount(); ++l) {
+        x >>= 1;
+        y >>= 1;
+        size_t i = indexOf(l, x, y);
+        levels[l].sums[i] += delta;
+        if (value > levels[l].maxes[i]) levels[l].maxes[i] = value;
+    }
+}
+
+void MipPyramid::set(int x, int y, std::uint32_t value) {
+    std::uint32_t& cell = base[index0(x, y)];
+    if (cell == value) return;
+    // Diferencia con signo aplicada a sumas sin signo (aritmética módulo 2^64)
+    std::uint64_t delta = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(cell);
+    bool grew = value > cell;
+    cell = value;
+
+    for (int l = 1; l < getLevelCount(); ++l) {
+        x >>= 1;
+        y >>= 1;
+        size_t i = indexOf(l, x, y);
+        levels[l].sums[i] += delta;
+        levels[l].maxes[i] = grew ? std::max(levels[l].maxes[i], value) : childMax(l, x, y);
+    }
+}
+
+void MipPyramid::assign(const std::vector<std::uint32_t>& values) {
+    if (values.size() != base.size()) return;
+    base = values;
+    rebuildLevels();
+}
+
+void MipPyramid::clear() {
+    std::fill(base.begin(), base.end(), 0);
+    for (size_t l = 1; l < levels.size(); ++l) {
+        std::fill(levels[l].sums.begin(), levels[l].sums.end(), 0);
+        std::fill(levels[l].maxes.begin(), levels[l].maxes.end(), 0);
+    }
+}
+
+void MipPyramid::rebuildLevels() {
+    for (int l = 1; l < getLevelCount(); ++l) {
+        Level& lv = levels[l];
+        const int cw = levels[l - 1].width, ch = levels[l - 1].height;
+        for (int y = 0; y < lv.height; ++y) {
+            for (int x = 0; x < lv.width; ++x) {
+                std::uint64_t sum = 0;
+                std::uint32_t best = 0;
+                for (int cy = y * 2; cy < std::min(y * 2 + 2, ch); ++cy) {
+                    for (int cx = x * 2; cx < std::min(x * 2 + 2, cw); ++cx) {
+                        sum += getSum(l - 1, cx, cy);
+                        best = std::max(best, getMax(l - 1, cx, cy));
+                    }
+                }
+                lv.sums[indexOf(l, x, y)] = sum;
+                lv.maxes[indexOf(l, x, y)] = best;
+            }
+        }
+    }
+}
+
+int MipPyramid::levelToFit(int maxWidth, int maxHeight) const {
+    for (int l = 0; l < getLevelCount(); ++l) {
+        if (levels[l].width <= maxWidth && levels[l].height <= maxHeight) return l;
+    }
+    return getLevelCount() - 1;
+}
+
+void MipPyramid::writeRGBA(int level, Reduce reduce, std::uint8_t* pixels) const {
+    const int lw = levels[level].width, lh = levels[level].height;
+    const size_t cells = static_cast<size_t>(lw) * lh;
+
+    auto valueAt = [&](size_t id) -> std::uint64_t {
+        int x = static_cast<int>(id % lw), y = static_cast<int>(id / lw);
+        return reduce == Reduce::SUM ? getSum(level, x, y) : getMax(level, x, y);
+    };
+
+    std::uint64_t top = 0;
+    for (size_t id = 0; id < cells; ++id) top = std::max(top, valueAt(id));
+
+    for (size_t id = 0; id < cells; ++id) {
+        std::uint64_t v = valueAt(id);
+        int lutIndex = 0;
+        if (v > 0 && top > 0) {
+            lutIndex = static_cast<int>((v * (HeatmapColormap::LUT_SIZE - 1) + top / 2) / top);
+            lutIndex = std::max(1, std::min(HeatmapColormap::LUT_SIZE - 1, lutIndex));
+        }
+        HeatmapColormap::writePixel(pixels, id, lutIndex);
+    }
+}
+
+size_t MipPyramid::bytesUsed() const {
+    size_t bytes = base.size() * sizeof(std::uint32_t);
+    for (const Level& lv : levels)
+        bytes += lv.sums.size() * sizeof(std::uint64_t) + lv.maxes.size() * sizeof(std::uint32_t);
+    return bytes;
+}
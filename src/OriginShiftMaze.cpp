@@ -89,6 +89,16 @@ void OriginShiftMaze::updateSingleRoot(int rootIndex) {
     std::uniform_int_distribution<int> dist(0, neighbors.size() - 1);
     auto [newRoot, dirToNewRoot] = neighbors[dist(rng)];
     
+    // Aristas afectadas: la nueva (raíz -> nueva raíz) y la que pierde la nueva raíz
+    pendingChanges.push_back(root);
+    pendingChanges.push_back(newRoot);
+    int oldParentDir = parentMap[newRoot.x][newRoot.y];
+    if (oldParentDir != -1) {
+        static const int dx[4] = {0, -1, 1, 0};
+        static const int dy[4] = {-1, 0, 0, 1};
+        pendingChanges.push_back(Coord(newRoot.x + dx[oldParentDir], newRoot.y + dy[oldParentDir]));
+    }
+    
     // La antigua raíz ahora apunta hacia la nueva raíz
     parentMap[root.x][root.y] = dirToNewRoot;
     
@@ -106,44 +116,24 @@ void OriginShiftMaze::update() {
 }
 
 void OriginShiftMaze::applyToGrid() {
-    // Resetear todas las paredes
-    for (int x = 0; x < g.width(); ++x) {
-        for (int y = 0; y < g.height(); ++y) {
-            for (int d = 0; d < 4; ++d) {
-                g.at(x, y).walls[d] = true;
-            }
-        }
-    }
+    // Resetear todas las paredes (también el hash de paredes)
+    g.resetWalls();
     
-    // Quitar paredes según parentMap
+    // Quitar paredes según parentMap (removeWall abre ambos lados y actualiza el hash)
     for (int x = 0; x < g.width(); ++x) {
         for (int y = 0; y < g.height(); ++y) {
             int parentDir = parentMap[x][y];
             if (parentDir == -1) continue;
             
-            g.at(x, y).walls[parentDir] = false;
-            
-            int nx = x, ny = y;
-            if (parentDir == 0) ny -= 1;
-            else if (parentDir == 1) nx -= 1;
-            else if (parentDir == 2) nx += 1;
-            else if (parentDir == 3) ny += 1;
-            
-            if (nx >= 0 && ny >= 0 && nx < g.width() && ny < g.height()) {
-                g.at(nx, ny).walls[oppositeDir(parentDir)] = false;
-            }
+            g.removeWall(y, x, static_cast<short>(parentDir));
         }
     }
+    
+    changedCells.swap(pendingChanges);
+    pendingChanges.clear();
 }
 
 int OriginShiftMaze::getEdgeCount() const {
-    int count = 0;
-    for (int x = 0; x < g.width(); ++x) {
-        for (int y = 0; y < g.height(); ++y) {
-            // Contar aristas hacia la derecha y hacia abajo para evitar duplicados
-            if (!g.at(x, y).walls[2] && x < g.width() - 1) count++;
-            if (!g.at(x, y).walls[3] && y < g.height() - 1) count++;
-        }
-    }
-    return count;
+    // Grid cuenta los pasajes abiertos en removeWall/resetWalls: O(1) por frame
+    return g.openPassageCount();
 }
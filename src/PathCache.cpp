@@ -0,0 +1,56 @@
+#include "PathCache.h"
+
+std::size_t PathCacheKeyHash::operator()(const PathCacheKey& k) const {
+    // El hash del laberinto ya está bien mezclado; combinar el resto encima
+    std::uint64_t h = k.mazeHash;
+    h ^= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(k.start.x)) << 32 |
+          static_cast<std::uint32_t>(k.start.y)) * 0x9E3779B97F4A7C15ULL;
+    h ^= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(k.goal.x)) << 32 |
+          static_cast<std::uint32_t>(k.goal.y)) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= static_cast<std::uint64_t>(k.strategy) * 0x165667B19E3779F9ULL;
+    return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+PathCache::PathCache(size_t cap) : capacity(cap == 0 ? 1 : cap) {}
+
+bool PathCache::get(const PathCacheKey& key, std::vector<Coord>& out) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+    // Mover al frente sin copiar (splice no invalida iteradores)
+    entries.splice(entries.begin(), entries, it->second);
+    out = it->second->path;
+    hits++;
+    return true;
+}
+
+void PathCache::put(const PathCacheKey& key, const std::vector<Coord>& path) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->path = path;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    if (index.size() >= capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+        evictions++;
+    }
+
+    entries.push_front({key, path});
+    index[key] = entries.begin();
+}
+
+void PathCache::clear() {
+    entries.clear();
+    index.clear();
+    hits = misses = evictions = 0;
+}
+
+float PathCache::getHitRate() const {
+    long long total = hits + misses;
+    return total > 0 ? static_cast<float>(hits) / static_cast<float>(total) : 0.0f;
+}
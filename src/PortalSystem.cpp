@@ -1,71 +1,130 @@
 #include "PortalSystem.h"
 #include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+
+namespace {
+const int NO_PORTAL_DISTANCE = std::numeric_limits<int>::max() / 4;
+}
 
 PortalSystem::PortalSystem(int gridW, int gridH)
-    : width(gridW), height(gridH), rng(std::random_device{}())
+    : width(gridW), height(gridH), rng(std::random_device{}()),
+      exitCell(gridW * gridH, -1),
+      portalDistance(gridW * gridH, NO_PORTAL_DISTANCE)
 {
 }
 
-void PortalSystem::generatePortals(const Coord& start, const Coord& goal, int count) {
+bool PortalSystem::inBounds(const Coord& c) const {
+    return c.x >= 0 && c.y >= 0 && c.x < width && c.y < height;
+}
+
+void PortalSystem::clear() {
     portals.clear();
-    
+    std::fill(exitCell.begin(), exitCell.end(), -1);
+    std::fill(portalDistance.begin(), portalDistance.end(), NO_PORTAL_DISTANCE);
+}
+
+void PortalSystem::generatePortals(const Coord& start, const Coord& goal, int count) {
+    clear();
+
     std::uniform_int_distribution<int> distX(0, width - 1);
     std::uniform_int_distribution<int> distY(0, height - 1);
-    
+
     for (int i = 0; i < count; ++i) {
         Portal p;
         int attempts = 0;
         const int maxAttempts = 100;
-        
+
         do {
             p.a = Coord(distX(rng), distY(rng));
             p.b = Coord(distX(rng), distY(rng));
             attempts++;
-            
+
             // Verificar que no sean iguales, no sean start/goal,
-            // y no colisionen con otros portales
+            // y no colisionen con otros portales (tabla densa, O(1))
             bool valid = !(p.a == p.b) &&
                          !(p.a == start) && !(p.a == goal) &&
-                         !(p.b == start) && !(p.b == goal);
-            
-            // Verificar que no colisione con portales existentes
-            if (valid) {
-                for (const auto& existing : portals) {
-                    if (p.a == existing.a || p.a == existing.b ||
-                        p.b == existing.a || p.b == existing.b) {
-                        valid = false;
-                        break;
-                    }
-                }
-            }
-            
+                         !(p.b == start) && !(p.b == goal) &&
+                         !isPortalCell(p.a) && !isPortalCell(p.b);
+
             // Asegurar distancia mínima entre puntos del portal (para que sea útil)
             if (valid) {
                 int dist = std::abs(p.a.x - p.b.x) + std::abs(p.a.y - p.b.y);
                 if (dist < 5) valid = false; // Distancia mínima Manhattan de 5
             }
-            
+
             if (valid) break;
-            
+
         } while (attempts < maxAttempts);
-        
+
         if (attempts < maxAttempts) {
-            portals.push_back(p);
+            addPortal(p.a, p.b);
         }
     }
 }
 
-std::optional<Coord> PortalSystem::getPortalExit(const Coord& pos) const {
-    for (const auto& p : portals) {
-        if (pos == p.a) return p.b;
-        if (pos == p.b) return p.a;
+bool PortalSystem::addPortal(const Coord& a, const Coord& b) {
+    if (!inBounds(a) || !inBounds(b) || a == b) return false;
+    if (isPortalCell(a) || isPortalCell(b)) return false;
+
+    portals.push_back({a, b});
+    exitCell[cellId(a)] = cellId(b);
+    exitCell[cellId(b)] = cellId(a);
+
+    relaxPortalDistance(a);
+    relaxPortalDistance(b);
+    return true;
+}
+
+void PortalSystem::relaxPortalDistance(const Coord& seed) {
+    // BFS sobre el grid abierto (distancia L1): solo continúa por celdas
+    // que mejoran, así el costo total es proporcional a lo que cambia
+    std::queue<Coord> q;
+    portalDistance[cellId(seed)] = 0;
+    q.push(seed);
+
+    const int dx[4] = {0, -1, 1, 0};
+    const int dy[4] = {-1, 0, 0, 1};
+
+    while (!q.empty()) {
+        Coord cur = q.front();
+        q.pop();
+        int nd = portalDistance[cellId(cur)] + 1;
+
+        for (int dir = 0; dir < 4; ++dir) {
+            Coord n(cur.x + dx[dir], cur.y + dy[dir]);
+            if (!inBounds(n)) continue;
+            if (portalDistance[cellId(n)] <= nd) continue;
+            portalDistance[cellId(n)] = nd;
+            q.push(n);
+        }
     }
-    return std::nullopt;
+}
+
+std::optional<Coord> PortalSystem::getPortalExit(const Coord& pos) const {
+    if (!inBounds(pos)) return std::nullopt;
+    int exitId = exitCell[cellId(pos)];
+    if (exitId < 0) return std::nullopt;
+    return Coord(exitId % width, exitId / width);
 }
 
 bool PortalSystem::isPortalCell(const Coord& pos) const {
-    for (const auto& p : portals) {
-        if (pos == p.a || pos == p.b) return true;
-    }
-    return false;
+    return inBounds(pos) && exitCell[cellId(pos)] >= 0;
+}
+
+int PortalSystem::nearestPortalDistance(const Coord& pos) const {
+    if (!inBounds(pos)) return NO_PORTAL_DISTANCE;
+    return portalDistance[cellId(pos)];
+}
+
+float PortalSystem::heuristic(const Coord& pos, const Coord& goal) const {
+    int direct = std::abs(goal.x - pos.x) + std::abs(goal.y - pos.y);
+    if (portals.empty()) return static_cast<float>(direct);
+
+    // Cualquier camino que use portales entra por alguna boca y sale por
+    // alguna boca: dist(pos, boca) + 1 + dist(boca, goal) es cota inferior
+    // incluso si se encadenan varios portales
+    int viaPortal = nearestPortalDistance(pos) + 1 + nearestPortalDistance(goal);
+    return static_cast<float>(std::min(direct, viaPortal));
 }
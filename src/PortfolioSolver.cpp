@@ -0,0 +1,123 @@
+#include "PortfolioSolver.h"
+#include "AStarSolver.h"
+#include "GreedySolver.h"
+#include "UCSSolver.h"
+#include "MazeSolver.h"
+#include "DeadEndFillSolver.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+PortfolioSolver::PortfolioSolver(const Grid& grid, Coord s, Coord g_,
+                                 std::vector<SolverStrategy> strats)
+    : g(grid), start(s), goal(g_), strategies(std::move(strats)) {}
+
+namespace {
+
+// Correr un solver hasta terminar o hasta que otro hilo gane
+template <typename Solver>
+bool raceSolver(Solver& solver, const std::atomic<bool>& cancelled, int& steps) {
+    // step() retorna true cuando termina (con o sin camino)
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        ++steps;
+        if (solver.step()) return !solver.getSolution().empty();
+    }
+    return false;
+}
+
+} // namespace
+
+PortfolioResult PortfolioSolver::solve() {
+    PortfolioResult result;
+    if (strategies.empty()) return result;
+
+    std::atomic<bool> cancelled(false);
+    std::atomic<int> winnerIndex(-1);
+    std::vector<std::vector<Coord>> paths(strategies.size());
+    std::vector<int> steps(strategies.size(), 0);
+    std::vector<float> finishTimes(strategies.size(), 0.0f);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    auto worker = [&](size_t i) {
+        bool found = false;
+        switch (strategies[i]) {
+            case SolverStrategy::ASTAR: {
+                AStarSolver solver(g, start, goal);
+                found = raceSolver(solver, cancelled, steps[i]);
+                if (found) paths[i] = solver.getSolution();
+                break;
+            }
+            case SolverStrategy::GREEDY: {
+                GreedySolver solver(g, start, goal);
+                found = raceSolver(solver, cancelled, steps[i]);
+                if (found) paths[i] = solver.getSolution();
+                break;
+            }
+            case SolverStrategy::UCS: {
+                UCSSolver solver(g, start, goal);
+                found = raceSolver(solver, cancelled, steps[i]);
+                if (found) paths[i] = solver.getSolution();
+                break;
+            }
+            case SolverStrategy::DFS: {
+                MazeSolver solver(g, start, goal);
+                found = raceSolver(solver, cancelled, steps[i]);
+                if (found) paths[i] = solver.getSolution();
+                break;
+            }
+            case SolverStrategy::DEADEND_FILL: {
+                DeadEndFillSolver solver(g, start, goal);
+                found = raceSolver(solver, cancelled, steps[i]);
+                if (found) paths[i] = solver.getSolution();
+                break;
+            }
+        }
+        if (!found) return;
+
+        std::chrono::duration<float> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+        finishTimes[i] = elapsed.count();
+
+        // Solo el primero en llegar gana; los demás ven la bandera y se detienen
+        int expected = -1;
+        if (winnerIndex.compare_exchange_strong(expected, static_cast<int>(i))) {
+            cancelled.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(strategies.size());
+    for (size_t i = 0; i < strategies.size(); ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& t : threads) t.join();
+
+    int w = winnerIndex.load();
+    if (w < 0) return result;  // Ninguna estrategia encontró camino
+
+    result.solved = true;
+    result.winner = strategies[w];
+    result.path = std::move(paths[w]);
+    result.elapsedTime = finishTimes[w];
+    result.winnerSteps = steps[w];
+    return result;
+}
+
+void PortfolioStats::recordWin(const std::string& generator, SolverStrategy winner) {
+    wins[generator][winner]++;
+}
+
+int PortfolioStats::getWins(const std::string& generator, SolverStrategy strategy) const {
+    auto it = wins.find(generator);
+    if (it == wins.end()) return 0;
+    auto jt = it->second.find(strategy);
+    return (jt != it->second.end()) ? jt->second : 0;
+}
+
+int PortfolioStats::getRaces(const std::string& generator) const {
+    auto it = wins.find(generator);
+    if (it == wins.end()) return 0;
+    int total = 0;
+    for (const auto& pair : it->second) total += pair.second;
+    return total;
+}
@@ -1,32 +1,31 @@
-#include "MazeAlgorithm.h"
+#include "CoroutineMazeAlgorithm.h"
 #include <vector>
 #include <cstdlib>
 #include <ctime>
 
-struct PrimsAlgorithm : public MazeAlgorithm {
-    Grid &g;
+struct PrimsAlgorithm : public CoroutineMazeAlgorithm {
     struct Frontier { int cx, cy, dir; };
-    std::vector<Frontier> frontier;
-    bool done = false;
-    Coord lastCarved;
 
-    PrimsAlgorithm(Grid &grid) : g(grid) {
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        int sx = std::rand() % g.width();
-        int sy = std::rand() % g.height();
-        g.at(sx, sy).visited = true;
-        addFrontierFrom(sx, sy);
-    }
+    PrimsAlgorithm(Grid &grid) : CoroutineMazeAlgorithm(generate(grid)) {}
 
-    void addFrontierFrom(int cx, int cy) {
+    static void addFrontierFrom(const Grid &g, std::vector<Frontier> &frontier, int cx, int cy) {
         if (cy > 0 && !g.at(cx, cy - 1).visited) frontier.push_back({cx, cy, 0});
         if (cy < g.height() - 1 && !g.at(cx, cy + 1).visited) frontier.push_back({cx, cy, 3});
         if (cx > 0 && !g.at(cx - 1, cy).visited) frontier.push_back({cx, cy, 1});
         if (cx < g.width() - 1 && !g.at(cx + 1, cy).visited) frontier.push_back({cx, cy, 2});
     }
 
-    bool step() override {
-        if (done) return true;
+    // Un co_yield por celda tallada; las entradas de frontera ya visitadas
+    // se descartan dentro del mismo paso
+    static Generator<Coord> generate(Grid &g) {
+        std::srand(static_cast<unsigned>(std::time(nullptr)));
+        int sx = std::rand() % g.width();
+        int sy = std::rand() % g.height();
+        g.at(sx, sy).visited = true;
+        std::vector<Frontier> frontier;
+        addFrontierFrom(g, frontier, sx, sy);
+        co_yield Coord(sx, sy);
+
         while (!frontier.empty()) {
             int idx = std::rand() % frontier.size();
             Frontier f = frontier[idx];
@@ -46,21 +45,13 @@ struct PrimsAlgorithm : public MazeAlgorithm {
             // carve
             g.removeWall(f.cy, f.cx, static_cast<short>(f.dir));
             g.at(nx, ny).visited = true;
-            addFrontierFrom(nx, ny);
-            lastCarved = Coord(nx, ny);
+            addFrontierFrom(g, frontier, nx, ny);
 
             // remove used frontier
             frontier[idx] = frontier.back();
             frontier.pop_back();
 
-            if (frontier.empty()) done = true;
-            return false; // one carve per step
+            if (!frontier.empty()) co_yield Coord(nx, ny);
         }
-
-        done = true;
-        return true;
     }
-
-    bool finished() const override { return done; }
-    bool getCurrent(Coord &out) const override { if (done) return false; out = lastCarved; return true; }
-};
\ No newline at end of file
+};
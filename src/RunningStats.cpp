@@ -0,0 +1,122 @@
+#include "RunningStats.h"
+#include <algorithm>
+#include <cmath>
+
+void Welford::add(double x) {
+    n++;
+    if (n == 1) {
+        min = max = x;
+    } else {
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+
+    double delta = x - mean;
+    mean += delta / static_cast<double>(n);
+    m2 += delta * (x - mean);
+}
+
+double Welford::getStdDev() const {
+    return std::sqrt(getVariance());
+}
+
+
+P2Quantile::P2Quantile(double quantile) : p(quantile) {}
+
+void P2Quantile::add(double x) {
+    // Primeras muestras: se guardan tal cual y luego inicializan los marcadores
+    if (n < EXACT_SAMPLES) {
+        samples[n++] = x;
+        if (n == EXACT_SAMPLES) initMarkers();
+        return;
+    }
+    n++;
+
+    // Celda k tal que q[k] <= x < q[k+1] (extendiendo los extremos)
+    int k;
+    if (x < q[0]) {
+        q[0] = x;
+        k = 0;
+    } else if (x >= q[4]) {
+        q[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && x >= q[k + 1]) k++;
+    }
+
+    for (int i = k + 1; i < 5; ++i) pos[i] += 1;
+    for (int i = 0; i < 5; ++i) desired[i] += step[i];
+
+    // Ajustar los marcadores centrales que se alejaron de su posición deseada
+    for (int i = 1; i <= 3; ++i) {
+        double d = desired[i] - pos[i];
+        if ((d >= 1 && pos[i + 1] - pos[i] > 1) || (d <= -1 && pos[i - 1] - pos[i] < -1)) {
+            int sign = d > 0 ? 1 : -1;
+            double candidate = parabolic(i, sign);
+            if (q[i - 1] < candidate && candidate < q[i + 1]) {
+                q[i] = candidate;
+            } else {
+                q[i] = linear(i, sign);
+            }
+            pos[i] += sign;
+        }
+    }
+}
+
+void P2Quantile::initMarkers() {
+    double sorted[EXACT_SAMPLES];
+    std::copy(samples, samples + EXACT_SAMPLES, sorted);
+    std::sort(sorted, sorted + EXACT_SAMPLES);
+
+    const double frac[5] = {0.0, p / 2, p, (1 + p) / 2, 1.0};
+    const double last = EXACT_SAMPLES - 1;
+    for (int i = 0; i < 5; ++i) {
+        pos[i] = std::round(frac[i] * last) + 1;
+        desired[i] = frac[i] * last + 1;
+        step[i] = frac[i];
+    }
+
+    // Posiciones estrictamente crecientes entre los extremos fijos
+    // (p cerca de 0 o 1 junta los marcadores centrales)
+    for (int i = 1; i <= 3; ++i) pos[i] = std::max(pos[i], pos[i - 1] + 1);
+    for (int i = 3; i >= 1; --i) pos[i] = std::min(pos[i], pos[i + 1] - 1);
+
+    for (int i = 0; i < 5; ++i) q[i] = sorted[static_cast<int>(pos[i]) - 1];
+}
+
+double P2Quantile::parabolic(int i, double d) const {
+    return q[i] + d / (pos[i + 1] - pos[i - 1]) *
+           ((pos[i] - pos[i - 1] + d) * (q[i + 1] - q[i]) / (pos[i + 1] - pos[i]) +
+            (pos[i + 1] - pos[i] - d) * (q[i] - q[i - 1]) / (pos[i] - pos[i - 1]));
+}
+
+double P2Quantile::linear(int i, int d) const {
+    return q[i] + d * (q[i + d] - q[i]) / (pos[i + d] - pos[i]);
+}
+
+double P2Quantile::value() const {
+    if (n == 0) return 0.0;
+    if (n > EXACT_SAMPLES) return q[2];
+
+    // Pocas muestras: cuantil exacto (interpolado) sobre las guardadas
+    double sorted[EXACT_SAMPLES];
+    std::copy(samples, samples + n, sorted);
+    std::sort(sorted, sorted + n);
+    double rank = p * static_cast<double>(n - 1);
+    int lo = static_cast<int>(rank);
+    int hi = std::min(lo + 1, static_cast<int>(n) - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+
+RunDistribution MetricSummary::summarize() const {
+    RunDistribution d;
+    d.runs = static_cast<int>(moments.count());
+    d.mean = static_cast<float>(moments.getMean());
+    d.stdDev = static_cast<float>(moments.getStdDev());
+    d.p50 = static_cast<float>(p50.value());
+    d.p95 = static_cast<float>(p95.value());
+    d.p99 = static_cast<float>(p99.value());
+    return d;
+}
@@ -2,37 +2,40 @@
 #include <algorithm>
 #include <limits>
 
-UCSSolver::UCSSolver(Grid &grid, Coord s, Coord g_)
-    : g(grid), start(s), goal(g_),
-      stateGrid(grid.width(), std::vector<CellState>(grid.height(), UNKNOWN)),
-      closed(grid.width(), std::vector<bool>(grid.height(), false)),
-      gScore(grid.width(), std::vector<float>(grid.height(), std::numeric_limits<float>::infinity())),
-      cameFrom(grid.width(), std::vector<Coord>(grid.height(), Coord(-1,-1))),
+UCSSolver::UCSSolver(const Grid &grid, Coord s, Coord g_, const PortalSystem *portals_)
+    : g(grid), start(s), goal(g_), portals(portals_),
+      state(grid.width(), grid.height()),
       current(s) {
+    PhaseTimer initTimer(stats.initTime);
 
-    gScore[start.x][start.y] = 0.0f;
+    state.setDistance(start.x, start.y, 0);
+    state.clearParent(start.x, start.y);
+    state.setState(start.x, start.y, CompactSearchState::OPEN);
     openPQ.push({0.0f, pushCounter++, start.x, start.y});
-    stateGrid[start.x][start.y] = OPEN;
+    stats.notePush(openPQ.size());
 }
 
 bool UCSSolver::step() {
     if (done) return true;
-    if (openPQ.empty()) { done = true; solved = false; return true; }
+    searchSpan.begin();
+    if (openPQ.empty()) { done = true; solved = false; searchSpan.end(stats.searchTime); return true; }
 
     PQNode node;
     do {
-        if (openPQ.empty()) { done = true; solved = false; return true; }
+        if (openPQ.empty()) { done = true; solved = false; searchSpan.end(stats.searchTime); return true; }
         node = openPQ.top();
         openPQ.pop();
-    } while (closed[node.x][node.y]);
+        if (state.isClosed(node.x, node.y)) stats.stalePops++;
+    } while (state.isClosed(node.x, node.y));
+    stats.pops++;
 
     int cx = node.x, cy = node.y;
     current = Coord(cx, cy);
 
-    closed[cx][cy] = true;
-    stateGrid[cx][cy] = CLOSED;
+    state.setState(cx, cy, CompactSearchState::CLOSED);
 
     if (cx == goal.x && cy == goal.y) {
+        searchSpan.end(stats.searchTime);
         reconstruct_path(cx, cy);
         done = true;
         solved = true;
@@ -49,29 +52,38 @@ bool UCSSolver::step() {
         else if (dir == 3) ny += 1;
 
         if (nx < 0 || ny < 0 || nx >= g.width() || ny >= g.height()) continue;
-        if (closed[nx][ny]) continue;
-
-        float tentative_cost = gScore[cx][cy] + 1.0f; // uniform edge cost
+        relax(cx, cy, nx, ny, dir);
+    }
 
-        if (tentative_cost < gScore[nx][ny]) {
-            cameFrom[nx][ny] = Coord(cx, cy);
-            gScore[nx][ny] = tentative_cost;
-            openPQ.push({gScore[nx][ny], pushCounter++, nx, ny});
-            stateGrid[nx][ny] = OPEN;
+    // portal edge (cost 1, like any other move)
+    if (portals) {
+        if (auto exit = portals->getPortalExit(Coord(cx, cy))) {
+            relax(cx, cy, exit->x, exit->y, -1);
         }
     }
 
     return false;
 }
 
-void UCSSolver::reconstruct_path(int x, int y) {
-    solution.clear();
-    Coord cur(x, y);
-    while (!(cur.x == -1 && cur.y == -1)) {
-        solution.push_back(cur);
-        cur = cameFrom[cur.x][cur.y];
+void UCSSolver::relax(int cx, int cy, int nx, int ny, int dir) {
+    if (state.isClosed(nx, ny)) return;
+
+    std::uint32_t tentative_cost = state.getDistance(cx, cy) + 1; // uniform edge cost
+
+    if (tentative_cost < state.getDistance(nx, ny)) {
+        if (state.isReached(nx, ny)) stats.reopenings++;
+        if (dir >= 0) state.setParentDir(nx, ny, CompactSearchState::oppositeDir(dir));
+        else state.setParentPortal(nx, ny);
+        state.setState(nx, ny, CompactSearchState::OPEN);
+        state.setDistance(nx, ny, tentative_cost);
+        openPQ.push({static_cast<float>(tentative_cost), pushCounter++, nx, ny});
+        stats.notePush(openPQ.size());
     }
-    std::reverse(solution.begin(), solution.end());
+}
+
+void UCSSolver::reconstruct_path(int x, int y) {
+    PhaseTimer pathTimer(stats.reconstructTime);
+    solution = state.tracePath(Coord(x, y), portals);
 }
 
 bool UCSSolver::finished() const { return done; }
@@ -83,3 +95,10 @@ bool UCSSolver::getCurrent(Coord &out) const {
 }
 
 const std::vector<Coord> &UCSSolver::getSolution() const { return solution; }
+
+SearchStats UCSSolver::getSearchStats() const {
+    SearchStats out = stats;
+    out.bytesAllocated = state.bytesUsed() + static_cast<size_t>(stats.peakOpen) * sizeof(PQNode)
+                       + solution.size() * sizeof(Coord);
+    return out;
+}
@@ -0,0 +1,88 @@
+#include "WallMesh.h"
+
+WallMesh::WallMesh(const Grid& g, float size, sf::Color col)
+    : grid(g), cellSize(size), color(col),
+      horizontal(g.height() + 1), vertical(g.width() + 1),
+      vertices(sf::PrimitiveType::Lines) {}
+
+void WallMesh::buildHorizontal(int k) {
+    Line& line = horizontal[k];
+    line.runs.clear();
+    line.version = grid.horizontalLineVersion(k);
+
+    // Pared entre la fila k-1 y la fila k (cualquiera de los dos lados la marca)
+    int runStart = -1;
+    for (int x = 0; x <= grid.width(); ++x) {
+        bool wall = x < grid.width() &&
+                    ((k < grid.height() && grid.at(x, k).walls[0]) || (k > 0 && grid.at(x, k - 1).walls[3]));
+        if (wall && runStart < 0) runStart = x;
+        if (!wall && runStart >= 0) {
+            line.runs.emplace_back(runStart, x);
+            runStart = -1;
+        }
+    }
+}
+
+void WallMesh::buildVertical(int k) {
+    Line& line = vertical[k];
+    line.runs.clear();
+    line.version = grid.verticalLineVersion(k);
+
+    // Pared entre la columna k-1 y la columna k
+    int runStart = -1;
+    for (int y = 0; y <= grid.height(); ++y) {
+        bool wall = y < grid.height() &&
+                    ((k < grid.width() && grid.at(k, y).walls[1]) || (k > 0 && grid.at(k - 1, y).walls[2]));
+        if (wall && runStart < 0) runStart = y;
+        if (!wall && runStart >= 0) {
+            line.runs.emplace_back(runStart, y);
+            runStart = -1;
+        }
+    }
+}
+
+void WallMesh::rebuildVertices() {
+    segmentCount = 0;
+    for (const Line& line : horizontal) segmentCount += line.runs.size();
+    for (const Line& line : vertical) segmentCount += line.runs.size();
+
+    vertices.resize(segmentCount * 2);
+    size_t i = 0;
+    auto emit = [&](float x1, float y1, float x2, float y2) {
+        vertices[i].position = sf::Vector2f(x1, y1);
+        vertices[i++].color = color;
+        vertices[i].position = sf::Vector2f(x2, y2);
+        vertices[i++].color = color;
+    };
+
+    for (size_t k = 0; k < horizontal.size(); ++k) {
+        float y = k * cellSize;
+        for (const auto& [from, to] : horizontal[k].runs) emit(from * cellSize, y, to * cellSize, y);
+    }
+    for (size_t k = 0; k < vertical.size(); ++k) {
+        float x = k * cellSize;
+        for (const auto& [from, to] : vertical[k].runs) emit(x, from * cellSize, x, to * cellSize);
+    }
+}
+
+void WallMesh::update() {
+    if (built && builtVersion == grid.wallVersion()) return;
+
+    for (int k = 0; k < static_cast<int>(horizontal.size()); ++k) {
+        if (!built || horizontal[k].version != grid.horizontalLineVersion(k)) buildHorizontal(k);
+    }
+    for (int k = 0; k < static_cast<int>(vertical.size()); ++k) {
+        if (!built || vertical[k].version != grid.verticalLineVersion(k)) buildVertical(k);
+    }
+
+    rebuildVertices();
+    builtVersion = grid.wallVersion();
+    built = true;
+}
+
+void WallMesh::draw(sf::RenderTarget& target, sf::Vector2f offset) {
+    update();
+    sf::RenderStates states;
+    states.transform.translate(offset);
+    target.draw(vertices, states);
+}
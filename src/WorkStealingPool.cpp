@@ -0,0 +1,67 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int threads) : threadCount(threads) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+}
+
+bool WorkStealingPool::popLocal(WorkQueue& q, size_t& index) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.items.empty()) return false;
+    index = q.items.back();
+    q.items.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::vector<WorkQueue>& queues, int thief, size_t& index) {
+    // Recorrer las demás colas empezando por la vecina
+    const int n = static_cast<int>(queues.size());
+    for (int k = 1; k < n; ++k) {
+        WorkQueue& victim = queues[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.items.empty()) continue;
+        index = victim.items.front();
+        victim.items.pop_front();
+        queues[thief].steals++;  // Contador propio: solo lo escribe el ladrón
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t index, int worker)>& task) {
+    lastSteals = 0;
+    if (count == 0) return;
+
+    int workers = static_cast<int>(std::min<size_t>(threadCount, count));
+    std::vector<WorkQueue> queues(workers);
+
+    // Bloques contiguos; se insertan al revés porque el dueño consume por el final
+    for (int w = 0; w < workers; ++w) {
+        size_t begin = count * w / workers;
+        size_t end = count * (w + 1) / workers;
+        for (size_t i = end; i > begin; --i) queues[w].items.push_back(i - 1);
+    }
+
+    // Nunca se agregan tareas durante run(): si no hay nada que robar, terminó
+    auto worker = [&](int w) {
+        size_t index;
+        while (popLocal(queues[w], index) || steal(queues, w, index)) {
+            task(index, w);
+        }
+    };
+
+    if (workers == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int w = 0; w < workers; ++w) threads.emplace_back(worker, w);
+        for (auto& th : threads) th.join();
+    }
+
+    for (const WorkQueue& q : queues) lastSteals += q.steals;
+}
@@ -7,22 +7,29 @@
 #include "AStarSolver.h"
 #include "GreedySolver.h"
 #include "UCSSolver.h"
+#include "DeadEndFillSolver.h"
 #include "ChallengeSystem.h"
 #include "CollectorSolver.h"
 #include "AlgorithmRankingAVL.h"
+#include "Leaderboard.h"
 #include "ExplorationHeatmap.h"
 #include "OriginShiftMaze.h"
 #include "PortalSystem.h"
 #include "GraphAnalysis.h"
+#include "PortfolioSolver.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "HeatmapColormap.h"
+#include "HeatmapAggregator.h"
+#include "BenchmarkRunner.h"
+#include "BenchmarkScheduler.h"
+#include "WallMesh.h"
 
 #include "DFSAlgorithm.cpp"
 #include "PrimsAlgorithm.cpp"
 #include "HuntAndKillAlgorithm.cpp"
 #include "KruskalsAlgorithm.cpp"
 #include "CollectorMazeGen.cpp"
-#include "OriginShiftMaze.cpp"
-#include "PortalSystem.cpp"
-#include "GraphAnalysis.cpp"
 
 #include <memory>
 #include <string>
@@ -32,10 +39,19 @@
 #include <limits>
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
 
 void displayHeatmap(const Grid& grid, const ExplorationHeatmap& heatmap,
-                   const sf::Font* fontPtr, const std::string& windowTitle);
+                   const sf::Font* fontPtr, const std::string& windowTitle,
+                   const std::function<void()>& advance = nullptr);
+void displayColorGrid(int viewW, int viewH, const std::vector<std::uint8_t>& pixels,
+                      const std::string& panelTitle, const std::vector<std::string>& infoLines,
+                      const sf::Font* fontPtr, const std::string& windowTitle,
+                      const std::function<bool()>& refresh = nullptr);
+
+// Lado máximo (px) del área de heatmap; grids más grandes se muestran por nivel de pirámide
+const int HEATMAP_VIEW_PX = 800;
 
 // Forward declaration for user vs computer mode
 void runUserVsComputer(int gridW, int gridH, const std::string &title,
@@ -61,6 +77,7 @@ std::string getStrategyName(SolverStrategy strategy) {
         case SolverStrategy::GREEDY: return "Greedy";
         case SolverStrategy::UCS: return "UCS";
         case SolverStrategy::DFS: return "DFS";
+        case SolverStrategy::DEADEND_FILL: return "Dead-End Fill";
         default: return "Unknown";
     }
 }
@@ -114,6 +131,9 @@ void runCollectorMode(Grid &grid, MazeAlgorithm &algo, ChallengeSystem &challeng
     std::unique_ptr<CollectorSolver> solver;
     bool solverInitialized = false;
 
+    // Tramos ya resueltos: se comparten entre ejecuciones del modo Collector
+    static PathCache collectorPathCache(512);
+
     auto drawLine = [&](sf::RenderTarget &target, float x1, float y1, float x2, float y2, const sf::Color &col) {
         sf::Vertex verts[2];
         verts[0].position = sf::Vector2f(x1, y1);
@@ -123,6 +143,9 @@ void runCollectorMode(Grid &grid, MazeAlgorithm &algo, ChallengeSystem &challeng
         target.draw(verts, 2, sf::PrimitiveType::Lines);
     };
 
+    // Paredes cacheadas: solo se rearman las líneas que cambian con removeWall
+    WallMesh wallMesh(grid, static_cast<float>(cellSize), sf::Color(220, 220, 220));
+
     while (window.isOpen()) {
         while (auto evOpt = window.pollEvent()) {
             const sf::Event &ev = *evOpt;
@@ -147,6 +170,11 @@ void runCollectorMode(Grid &grid, MazeAlgorithm &algo, ChallengeSystem &challeng
                 algo.step();
             } else if (!solverInitialized) {
                 solver = std::make_unique<CollectorSolver>(grid, challenges, start, goal, strategy);
+                solver->setPathCache(&collectorPathCache);
+                // Grid más grande que la vista del heatmap [H]: pirámide mantenida en cada visita
+                if (grid.width() > HEATMAP_VIEW_PX || grid.height() > HEATMAP_VIEW_PX) {
+                    solver->getHeatmap().enablePyramid();
+                }
                 solverInitialized = true;
             } else if (!solver->finished()) {
                 solver->step();
@@ -168,13 +196,9 @@ void runCollectorMode(Grid &grid, MazeAlgorithm &algo, ChallengeSystem &challeng
                     rect.setFillColor(sf::Color(46, 46, 46));
                     window.draw(rect);
                 }
-
-                if (grid.at(x, y).walls[0]) drawLine(window, xpos, ypos, xpos + cellSize, ypos, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[1]) drawLine(window, xpos, ypos, xpos, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[2]) drawLine(window, xpos + cellSize, ypos, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[3]) drawLine(window, xpos, ypos + cellSize, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
             }
         }
+        wallMesh.draw(window);  // Todas las paredes en una sola llamada
 
         // Treasures
         const std::vector<Coord>& treasures = challenges.getTreasurePositions();
@@ -313,6 +337,14 @@ void runCollectorMode(Grid &grid, MazeAlgorithm &algo, ChallengeSystem &challeng
                  tText.setPosition(sf::Vector2f(6.f, 26.f));
                  tText.setFillColor(sf::Color(255, 215, 0));
                  window.draw(tText);
+
+                 std::string cacheText = "Path cache: " + std::to_string(collectorPathCache.getHits()) + " hits / " +
+                                         std::to_string(collectorPathCache.getMisses()) + " misses (" +
+                                         std::to_string(static_cast<int>(collectorPathCache.getHitRate() * 100.0f)) + "%)";
+                 sf::Text cText(*fontPtr, cacheText, 12);
+                 cText.setPosition(sf::Vector2f(6.f, 46.f));
+                 cText.setFillColor(sf::Color(180, 180, 180));
+                 window.draw(cText);
                  
                  // Hint at the end
                  if (solver->finished()) {
@@ -341,9 +373,7 @@ void runUserVsComputer(int gridW, int gridH, const std::string &title,
     // Generate Maze
     Grid grid(gridW, gridH);
     DFSAlgorithm generator(grid);
-    while(!generator.finished()) {
-        generator.step();
-    }
+    generator.runToEnd();
     Coord start(0, 0);
     Coord goal(gridW - 1, gridH - 1);
 
@@ -477,13 +507,8 @@ void runUserVsComputer(int gridW, int gridH, const std::string &title,
         }
     };
 
-    auto drawLine = [&](sf::RenderTarget &target, float x1, float y1, float x2, float y2, const sf::Color &col) {
-        sf::Vertex line[] = {
-            {sf::Vector2f(x1, y1), col},
-            {sf::Vector2f(x2, y2), col}
-        };
-        target.draw(line, 2, sf::PrimitiveType::Lines);
-    };
+    // Paredes cacheadas: una sola llamada por tablero (el laberinto no cambia durante la partida)
+    WallMesh wallMesh(grid, static_cast<float>(cellSize), CP_WALL);
 
     auto drawMaze = [&](float offsetX, const Coord& playerPos, const sf::Color& playerColor, bool isUser) {
         // Trace
@@ -502,18 +527,8 @@ void runUserVsComputer(int gridW, int gridH, const std::string &title,
             drawSolverTrace(offsetX);
         }
 
-        // Walls
-        for (int y = 0; y < grid.height(); ++y) {
-            for (int x = 0; x < grid.width(); ++x) {
-                float xpos = offsetX + x * cellSize;
-                float ypos = y * cellSize;
-
-                if (grid.at(x, y).walls[0]) drawLine(window, xpos, ypos, xpos + cellSize, ypos, CP_WALL);
-                if (grid.at(x, y).walls[1]) drawLine(window, xpos, ypos, xpos, ypos + cellSize, CP_WALL);
-                if (grid.at(x, y).walls[2]) drawLine(window, xpos + cellSize, ypos, xpos + cellSize, ypos + cellSize, CP_WALL);
-                if (grid.at(x, y).walls[3]) drawLine(window, xpos, ypos + cellSize, xpos + cellSize, ypos + cellSize, CP_WALL);
-            }
-        }
+        // Walls (misma malla para los dos tableros, desplazada)
+        wallMesh.draw(window, sf::Vector2f(offsetX, 0.0f));
         
         // Solution Path
         if (!isUser && solverWon) {
@@ -649,25 +664,20 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
     sf::Time stepTime = sf::milliseconds(8);
 
     bool solverChosen = false;
-    enum SolverType { SOLVER_NONE = 0, SOLVER_DFS, SOLVER_ASTAR, SOLVER_GREEDY, SOLVER_UCS };
+    enum SolverType { SOLVER_NONE = 0, SOLVER_DFS, SOLVER_ASTAR, SOLVER_GREEDY, SOLVER_UCS, SOLVER_DEADEND };
     SolverType solverType = SOLVER_NONE;
 
     std::unique_ptr<MazeSolver> dfsSolver;
     std::unique_ptr<AStarSolver> aStarSolver;
     std::unique_ptr<GreedySolver> greedySolver;
     std::unique_ptr<UCSSolver> ucsSolver;
+    std::unique_ptr<DeadEndFillSolver> deadEndSolver;
 
     Coord start(0, 0);
     Coord goal(grid.width() - 1, grid.height() - 1);
 
-    auto drawLine = [&](sf::RenderTarget &target, float x1, float y1, float x2, float y2, const sf::Color &col) {
-        sf::Vertex verts[2];
-        verts[0].position = sf::Vector2f(x1, y1);
-        verts[0].color = col;
-        verts[1].position = sf::Vector2f(x2, y2);
-        verts[1].color = col;
-        target.draw(verts, 2, sf::PrimitiveType::Lines);
-    };
+    // Paredes cacheadas: solo se rearman las líneas que cambian con removeWall
+    WallMesh wallMesh(grid, static_cast<float>(cellSize), sf::Color(220, 220, 220));
 
     while (window.isOpen()) {
         while (auto evOpt = window.pollEvent()) {
@@ -688,7 +698,8 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
                         "DFS",
                         "A*",
                         "Greedy Best-First",
-                        "Uniform Cost Search"
+                        "Uniform Cost Search",
+                        "Dead-End Fill"
                     };
                     Menu solverMenu(solverOptions, "Choose Solver");
                     int solverChoice = solverMenu.run(window);
@@ -706,6 +717,9 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
                     } else if (solverChoice == 3) {
                         ucsSolver = std::make_unique<UCSSolver>(grid, start, goal);
                         solverType = SOLVER_UCS;
+                    } else if (solverChoice == 4) {
+                        deadEndSolver = std::make_unique<DeadEndFillSolver>(grid, start, goal);
+                        solverType = SOLVER_DEADEND;
                     }
 
                     solverChosen = true;
@@ -714,6 +728,7 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
                     else if (solverType == SOLVER_ASTAR && aStarSolver && !aStarSolver->finished()) aStarSolver->step();
                     else if (solverType == SOLVER_GREEDY && greedySolver && !greedySolver->finished()) greedySolver->step();
                     else if (solverType == SOLVER_UCS && ucsSolver && !ucsSolver->finished()) ucsSolver->step();
+                    else if (solverType == SOLVER_DEADEND && deadEndSolver && !deadEndSolver->finished()) deadEndSolver->step();
                 }
             }
             accumulator -= stepTime;
@@ -732,13 +747,9 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
                     rect.setFillColor(sf::Color(46, 46, 46));
                     window.draw(rect);
                 }
-
-                if (grid.at(x, y).walls[0]) drawLine(window, xpos, ypos, xpos + cellSize, ypos, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[1]) drawLine(window, xpos, ypos, xpos, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[2]) drawLine(window, xpos + cellSize, ypos, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[3]) drawLine(window, xpos, ypos + cellSize, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
             }
         }
+        wallMesh.draw(window);  // Todas las paredes en una sola llamada
 
         Coord genCur;
         if (!algo.finished() && algo.getCurrent(genCur)) {
@@ -802,12 +813,25 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
             if (solverType == SOLVER_ASTAR) drawStateAndHeat(aStarSolver);
             else if (solverType == SOLVER_GREEDY) drawStateAndHeat(greedySolver);
             else if (solverType == SOLVER_UCS) drawStateAndHeat(ucsSolver);
+            else if (solverType == SOLVER_DEADEND && deadEndSolver) {
+                // Callejones rellenados hasta ahora
+                for (int y = 0; y < grid.height(); ++y) {
+                    for (int x = 0; x < grid.width(); ++x) {
+                        if (!deadEndSolver->isDeadEnd(x, y)) continue;
+                        sf::RectangleShape r(sf::Vector2f((float)cellSize, (float)cellSize));
+                        r.setPosition(sf::Vector2f((float)x * cellSize, (float)y * cellSize));
+                        r.setFillColor(sf::Color(90, 30, 40, 140));
+                        window.draw(r);
+                    }
+                }
+            }
 
             const std::vector<Coord> *pathPtr = nullptr;
             if (solverType == SOLVER_DFS && dfsSolver) pathPtr = &dfsSolver->getSolution();
             if (solverType == SOLVER_ASTAR && aStarSolver) pathPtr = &aStarSolver->getSolution();
             if (solverType == SOLVER_GREEDY && greedySolver) pathPtr = &greedySolver->getSolution();
             if (solverType == SOLVER_UCS && ucsSolver) pathPtr = &ucsSolver->getSolution();
+            if (solverType == SOLVER_DEADEND && deadEndSolver) pathPtr = &deadEndSolver->getSolution();
 
             if (pathPtr && !pathPtr->empty()) {
                 for (const Coord &c : *pathPtr) {
@@ -848,110 +872,143 @@ void runAlgorithm(Grid &grid, MazeAlgorithm &algo, int cellSize, const std::stri
 // BENCHMARK Y RANKING DE ALGORITMOS
 // ===================================
 
-// Ejecutar UN benchmark: un solver en un laberinto generado
-AlgorithmStats runSingleBenchmark(const std::string& genAlgo, SolverStrategy strategy,
-                                  const std::string& solverName, int gridW, int gridH) {
-    AlgorithmStats stats;
-    stats.algorithmName = solverName;
-
-    Grid grid(gridW, gridH);
-    ChallengeSystem challenges(grid);
-
-    Coord start(gridW / 2, gridH / 2);
-    Coord goal = getRandomCorner(grid, start);
+// Carrera de portafolio: qué estrategia entrega primero un camino en cada tipo de laberinto
+PortfolioStats runPortfolioBenchmark(const std::vector<std::string>& genAlgos, int iterations,
+                                     int gridW, int gridH) {
+    PortfolioStats portfolioStats;
 
-    // Generar laberinto (sin visualización, sin contar tiempo)
-    std::unique_ptr<MazeAlgorithm> algo;
-    if (genAlgo == "DFS") {
-        algo.reset(new DFSCollectorAlgorithm(grid, &challenges));
-    } else if (genAlgo == "Prim's") {
-        algo.reset(new PrimsCollectorAlgorithm(grid, &challenges));
-    } else if (genAlgo == "Hunt&Kill") {
-        algo.reset(new HuntAndKillCollectorAlgorithm(grid, &challenges));
-    } else if (genAlgo == "Kruskal's") {
-        algo.reset(new KruskalsCollectorAlgorithm(grid, &challenges));
-    }
+    for (const auto& genAlgo : genAlgos) {
+        for (int i = 0; i < iterations; i++) {
+            Grid grid(gridW, gridH);
+            std::unique_ptr<MazeAlgorithm> algo = makeCollectorGenerator(genAlgo, grid, nullptr);
+            algo->runToEnd();
 
-    while (!algo->finished()) {
-        algo->step();
-    }
+            Coord start(gridW / 2, gridH / 2);
+            Coord goal = getRandomCorner(grid, start);
 
-    // Resolver laberinto (SOLO medir tiempo del solving)
-    auto startTime = std::chrono::high_resolution_clock::now();
-    CollectorSolver solver(grid, challenges, start, goal, strategy);
-
-    while (!solver.finished()) {
-        solver.step();
+            PortfolioSolver portfolio(grid, start, goal);
+            PortfolioResult result = portfolio.solve();
+            if (result.solved) {
+                portfolioStats.recordWin(genAlgo, result.winner);
+            }
+        }
     }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<float> duration = endTime - startTime;
-
-    // Recopilar estadísticas REALES
-    stats.nodesExpanded = solver.getNodesExpanded();  // Contador real
-    stats.pathLength = static_cast<int>(solver.getFullPath().size());
-    stats.executionTime = duration.count();
-    stats.treasuresCollected = solver.getTreasuresCollected();
-
-    return stats;
+    return portfolioStats;
 }
 
 void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
     const int ITERATIONS_PER_MAZE_TYPE = 30;  // Iteraciones por cada tipo de laberinto
 
-    std::vector<std::string> genAlgos = {"DFS", "Prim's", "Hunt&Kill", "Kruskal's"};
-    std::vector<std::pair<SolverStrategy, std::string>> solvers = {
-        {SolverStrategy::ASTAR, "A*"},
-        {SolverStrategy::GREEDY, "Greedy"},
-        {SolverStrategy::UCS, "UCS"},
-        {SolverStrategy::DFS, "DFS"}
-    };
+    const std::vector<std::string>& genAlgos = benchmarkGenerators();
+    const std::vector<std::pair<SolverStrategy, std::string>>& solvers = benchmarkSolvers();
 
     AlgorithmRankingAVL ranking;
+    AlgorithmRankingAVL mazeRanking;  // Mismo resumen por (solver, tipo de laberinto)
+
+    // Ranking histórico: cada corrida va al log en disco desde un hilo escritor
+    Leaderboard leaderboard("leaderboard");
+    if (!leaderboard.open()) {
+        std::cout << "Aviso: no se pudo abrir leaderboard.log (historial solo en memoria)\n";
+    }
+    leaderboard.startWriter();
+    bool showAllTime = false;
+
+    // Todos los solvers compiten en los mismos laberintos (seed de la sesión);
+    // se generan en serie y se resuelven en paralelo con robo de trabajo
+    BenchmarkConfig config;
+    config.generators = genAlgos;
+    config.solvers = solvers;
+    config.iterations = ITERATIONS_PER_MAZE_TYPE;
+    config.width = GRID_W;
+    config.height = GRID_H;
+    config.baseSeed = static_cast<unsigned>(std::time(nullptr));
+    BenchmarkScheduler scheduler(config);
+
+    // Heatmap agregado por estrategia: dónde gasta tiempo cada solver (un shard por hilo)
+    std::vector<HeatmapAggregator> wasteMaps;
+    wasteMaps.reserve(solvers.size());
+    for (size_t s = 0; s < solvers.size(); ++s) wasteMaps.emplace_back(GRID_W, GRID_H, scheduler.getThreadCount());
 
     std::cout << "\n=== Ejecutando Benchmark de Solvers ===\n";
     std::cout << "Cada solver se prueba en laberintos generados por " << genAlgos.size() << " algoritmos diferentes\n";
     std::cout << "Iteraciones por tipo de laberinto: " << ITERATIONS_PER_MAZE_TYPE << "\n";
-    std::cout << "Total de tests por solver: " << genAlgos.size() * ITERATIONS_PER_MAZE_TYPE << "\n\n";
+    std::cout << "Total de tests por solver: " << genAlgos.size() * ITERATIONS_PER_MAZE_TYPE << "\n";
+    std::cout << "Hilos: " << scheduler.getThreadCount() << "\n\n";
+
+    std::vector<BenchmarkResult> results = scheduler.run(&wasteMaps);
+    std::cout << "Generación: " << scheduler.getLastGenerateSeconds() * 1000.0 << " ms (serie) | Resolución: "
+              << scheduler.getLastSolveSeconds() * 1000.0 << " ms (" << scheduler.getThreadCount()
+              << " hilos, " << scheduler.getLastSteals() << " tareas robadas)\n\n";
+
+    // Agregación en línea y en orden fijo (no depende de los hilos):
+    // media/varianza y p50/p95/p99 sin guardar corridas
+    std::vector<AlgorithmStatsAccumulator> solverAccs(solvers.size());
+    std::vector<AlgorithmStatsAccumulator> mazeAccs(solvers.size() * genAlgos.size());
+    for (const BenchmarkResult& r : results) {
+        leaderboard.submit(r.stats);
+        solverAccs[r.solver].add(r.stats);
+        mazeAccs[r.solver * genAlgos.size() + r.generator].add(r.stats);
+    }
 
-    // Ejecutar benchmarks SOLO para solvers
-    for (const auto& solverPair : solvers) {
+    for (size_t s = 0; s < solvers.size(); ++s) {
+        const auto& solverPair = solvers[s];
         std::cout << "Testing solver: " << solverPair.second << "...\n";
 
-        AlgorithmStats avgStats;
-        avgStats.algorithmName = solverPair.second;
-
-        int totalTests = 0;
-
-        // Probar en todos los tipos de laberintos
-        for (const auto& genAlgo : genAlgos) {
+        // Resultados en todos los tipos de laberintos
+        for (size_t g = 0; g < genAlgos.size(); ++g) {
+            const std::string& genAlgo = genAlgos[g];
             std::cout << "  " << genAlgo << " laberintos... ";
 
-            for (int i = 0; i < ITERATIONS_PER_MAZE_TYPE; i++) {
-                AlgorithmStats stats = runSingleBenchmark(genAlgo, solverPair.first, solverPair.second, GRID_W, GRID_H);
-                avgStats.nodesExpanded += stats.nodesExpanded;
-                avgStats.pathLength += stats.pathLength;
-                avgStats.executionTime += stats.executionTime;
-                avgStats.treasuresCollected += stats.treasuresCollected;
-
-                totalTests++;
-            }
-
-            std::cout << "OK\n";
+            AlgorithmStats mazeStats = mazeAccs[s * genAlgos.size() + g].summarize(solverPair.second + " @ " + genAlgo);
+            mazeRanking.insert(mazeStats);
+            std::cout << "OK  nodos p50/p95=" << mazeStats.nodesDist.p50 << "/" << mazeStats.nodesDist.p95
+                      << "  tiempo p50/p95/p99=" << mazeStats.timeDist.p50 * 1000.0f << "/"
+                      << mazeStats.timeDist.p95 * 1000.0f << "/" << mazeStats.timeDist.p99 * 1000.0f << " ms\n";
         }
 
-        // Calcular promedios
-        avgStats.nodesExpanded /= totalTests;
-        avgStats.pathLength /= totalTests;
-        avgStats.executionTime /= totalTests;
-        avgStats.treasuresCollected /= totalTests;
-
+        AlgorithmStats avgStats = solverAccs[s].summarize(solverPair.second);
         ranking.insert(avgStats);
-        std::cout << "  Score final: " << avgStats.calculateScore() << "\n\n";
+        std::cout << "  Score final: " << avgStats.calculateScore() << "\n";
+        std::cout << "  Nodos: media " << avgStats.nodesDist.mean << " +- " << avgStats.nodesDist.stdDev
+                  << " | p50/p95/p99 " << avgStats.nodesDist.p50 << "/" << avgStats.nodesDist.p95
+                  << "/" << avgStats.nodesDist.p99 << "\n";
+        std::cout << "  Tiempo: media " << avgStats.timeDist.mean * 1000.0f << " +- " << avgStats.timeDist.stdDev * 1000.0f
+                  << " ms | p50/p95/p99 " << avgStats.timeDist.p50 * 1000.0f << "/" << avgStats.timeDist.p95 * 1000.0f
+                  << "/" << avgStats.timeDist.p99 * 1000.0f << " ms\n";
+        std::cout << "  Contadores (promedio): " << avgStats.search << "\n";
+
+        // Guardar el heatmap agregado (se puede comparar entre sesiones)
+        HeatmapAggregator& wasteMap = wasteMaps[s];
+        wasteMap.merge();
+        std::string mapFile = "heatmap_ranking_" + std::to_string(s + 1) + ".bin";
+        if (wasteMap.save(mapFile)) {
+            std::cout << "  Heatmap agregado (" << wasteMap.getRuns() << " corridas): " << mapFile << "\n";
+        }
+        std::cout << "\n";
     }
 
     std::cout << "=== Benchmark Completado ===\n\n";
 
+    std::cout << "=== Ranking por solver y tipo de laberinto (medianas) ===\n";
+    for (const RankEntry& entry : mazeRanking.getAll()) {
+        std::cout << "  " << entry.rank << ". " << entry.stats.algorithmName
+                  << "  score " << static_cast<int>(entry.stats.calculateScore()) << "\n";
+    }
+    std::cout << "\n";
+
+    // Portafolio: todas las estrategias compiten en paralelo sobre el mismo laberinto
+    std::cout << "=== Portfolio (primer camino entregado) ===\n";
+    PortfolioStats portfolioStats = runPortfolioBenchmark(genAlgos, ITERATIONS_PER_MAZE_TYPE, GRID_W, GRID_H);
+    for (const auto& genAlgo : genAlgos) {
+        std::cout << "  " << genAlgo << " (" << portfolioStats.getRaces(genAlgo) << " carreras):";
+        for (const auto& solverPair : solvers) {
+            std::cout << " " << solverPair.second << "=" << portfolioStats.getWins(genAlgo, solverPair.first);
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+
     // Mostrar resultados en ventana
     std::vector<RankEntry> topRankings = ranking.getAll();
 
@@ -965,27 +1022,60 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
                 rankWindow.close();
                 return;
             }
+
+            // Teclas 1..N: heatmap agregado de cada solver (orden del benchmark)
+            if (const auto* keyEv = ev.getIf<sf::Event::KeyPressed>()) {
+                if (keyEv->code == sf::Keyboard::Key::H) {
+                    showAllTime = !showAllTime;
+                }
+
+                int index = static_cast<int>(keyEv->code) - static_cast<int>(sf::Keyboard::Key::Num1);
+                if (index >= 0 && index < static_cast<int>(wasteMaps.size())) {
+                    const HeatmapAggregator& wasteMap = wasteMaps[index];
+                    std::vector<std::string> infoLines = {
+                        "Solver: " + solvers[index].second,
+                        "Runs: " + std::to_string(wasteMap.getRuns()),
+                        "Total Visits: " + std::to_string(wasteMap.getTotalVisits()),
+                        "Max Visits: " + std::to_string(wasteMap.getMaxVisits()),
+                        "Avg / Run: " + std::to_string(wasteMap.getRuns() ? wasteMap.getTotalVisits() / wasteMap.getRuns() : 0)
+                    };
+                    std::vector<std::uint8_t> pixels(static_cast<size_t>(wasteMap.getWidth()) * wasteMap.getHeight() * 4);
+                    HeatmapColormap::writeNormalized(wasteMap.toNormalizedGrid(), pixels.data());
+                    displayColorGrid(wasteMap.getWidth(), wasteMap.getHeight(), pixels, "Aggregated Heatmap", infoLines, fontPtr,
+                                     "Where " + solvers[index].second + " spends its time");
+                }
+            }
         }
 
         rankWindow.clear(sf::Color(30, 30, 40));
 
         if (fontPtr) {
+            // Vista: esta sesión o historial (snapshot inmutable, sin locks)
+            std::shared_ptr<const LeaderboardSnapshot> history = leaderboard.snapshot();
+            std::vector<RankEntry> allTimeRankings;
+            if (showAllTime) {
+                for (const LeaderboardEntry& e : history->getAll()) allTimeRankings.emplace_back(e.stats, e.rank);
+            }
+            const std::vector<RankEntry>& shownRankings = showAllTime ? allTimeRankings : topRankings;
+
             // Título
-            sf::Text titleText(*fontPtr, "Algorithm Ranking (AVL Tree)", 28);
+            sf::Text titleText(*fontPtr, showAllTime ? "Algorithm Ranking (All-Time)" : "Algorithm Ranking (AVL Tree)", 28);
             titleText.setPosition(sf::Vector2f(30, 20));
             titleText.setFillColor(sf::Color(255, 215, 0));
             rankWindow.draw(titleText);
 
             // Subtítulo
             int totalTests = 4 * ITERATIONS_PER_MAZE_TYPE;
-            sf::Text subtitle(*fontPtr, "Cada solver probado en " + std::to_string(totalTests) + " laberintos (4 tipos x " + std::to_string(ITERATIONS_PER_MAZE_TYPE) + " iteraciones)", 14);
+            sf::Text subtitle(*fontPtr, showAllTime
+                ? "Promedio de " + std::to_string(history->getTotalRuns()) + " corridas guardadas en leaderboard.log/.snap"
+                : "Cada solver probado en " + std::to_string(totalTests) + " laberintos (4 tipos x " + std::to_string(ITERATIONS_PER_MAZE_TYPE) + " iteraciones)", 14);
             subtitle.setPosition(sf::Vector2f(30, 55));
             subtitle.setFillColor(sf::Color(180, 180, 180));
             rankWindow.draw(subtitle);
 
             // Encabezados
             float yPos = 100;
-            sf::Text header(*fontPtr, "Rank  Solver Algorithm           Score    Nodes   Time(ms)  Treasures", 14);
+            sf::Text header(*fontPtr, "Rank  Solver Algorithm           Score    Nodes   Time p50/p95(ms)  Treasures", 14);
             header.setPosition(sf::Vector2f(30, yPos));
             header.setFillColor(sf::Color(200, 200, 200));
             header.setStyle(sf::Text::Bold);
@@ -994,8 +1084,8 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
             yPos += 40;
 
             // Resultados
-            for (size_t i = 0; i < topRankings.size(); i++) {
-                const RankEntry& entry = topRankings[i];
+            for (size_t i = 0; i < shownRankings.size(); i++) {
+                const RankEntry& entry = shownRankings[i];
 
                 // Color según ranking (mejor = verde, peor = rojo)
                 sf::Color rowColor;
@@ -1009,10 +1099,19 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
                 // Padding para alinear
                 while (line.length() < 33) line += " ";
 
-                line += std::to_string(static_cast<int>(entry.stats.calculateScore())) + "     ";
-                line += std::to_string(entry.stats.nodesExpanded) + "      ";
-                line += std::to_string(static_cast<int>(entry.stats.executionTime * 1000)) + "       ";
-                line += std::to_string(entry.stats.treasuresCollected);
+                // Con distribución: medianas (lo que usa el score) y p95 del tiempo
+                const AlgorithmStats& st = entry.stats;
+                bool hasDist = st.timeDist.runs > 0;
+                int nodes = hasDist ? static_cast<int>(st.nodesDist.p50) : st.nodesExpanded;
+                std::string timeCol = hasDist
+                    ? std::to_string(static_cast<int>(st.timeDist.p50 * 1000)) + "/" + std::to_string(static_cast<int>(st.timeDist.p95 * 1000))
+                    : std::to_string(static_cast<int>(st.executionTime * 1000));
+
+                line += std::to_string(static_cast<int>(st.calculateScore())) + "     ";
+                line += std::to_string(nodes) + "      ";
+                line += timeCol;
+                while (line.length() < 68) line += " ";
+                line += std::to_string(st.treasuresCollected);
 
                 sf::Text rankText(*fontPtr, line, 16);
                 rankText.setPosition(sf::Vector2f(30, yPos));
@@ -1025,9 +1124,9 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
             // Explicación
             yPos += 20;
             std::vector<std::string> explanations = {
-                "Score = 1000 - (nodos*0.5) - (tiempo*500) + (tesoros*50)",
-                "Nodes = Nodos expandidos (celdas marcadas como CLOSED)",
-                "Time = Tiempo promedio de resoluci\u00f3n en milisegundos"
+                "Score = 1000 - (nodos*0.5) - (tiempo*500) + (tesoros*50), con medianas (p50) por corrida",
+                "Nodes = Mediana de nodos expandidos (celdas marcadas como CLOSED)",
+                "Time = Percentiles 50/95 del tiempo de resoluci\u00f3n en milisegundos"
             };
 
             for (const auto& expl : explanations) {
@@ -1039,7 +1138,7 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
             }
 
             // Instrucciones
-            sf::Text hint(*fontPtr, "Close window to return to menu", 14);
+            sf::Text hint(*fontPtr, "[1-" + std::to_string(wasteMaps.size()) + "] Aggregated heatmap per solver  |  [H] Session / all-time  |  Close window to return to menu", 14);
             hint.setPosition(sf::Vector2f(30, 650));
             hint.setFillColor(sf::Color(150, 150, 150));
             rankWindow.draw(hint);
@@ -1058,9 +1157,7 @@ void runAlgorithmRanking(sf::RenderWindow& window, const sf::Font* fontPtr) {
 }
 
 void showHeatmapVisualization(sf::RenderWindow& window, const sf::Font* fontPtr) {
-    const int CELL_SIZE = 20;
-
-    // Generar laberinto y resolver con A*
+    // Generar laberinto y resolver con A* mientras se muestra el heatmap
     Grid grid(GRID_W, GRID_H);
     ChallengeSystem challenges(grid);
 
@@ -1068,36 +1165,144 @@ void showHeatmapVisualization(sf::RenderWindow& window, const sf::Font* fontPtr)
     Coord goal = getRandomCorner(grid, start);
 
     std::unique_ptr<MazeAlgorithm> algo(new DFSCollectorAlgorithm(grid, &challenges));
-    while (!algo->finished()) {
-        algo->step();
-    }
+    algo->runToEnd();
 
     CollectorSolver solver(grid, challenges, start, goal, SolverStrategy::ASTAR);
-    while (!solver.finished()) {
-        solver.step();
+
+    // Vista en vivo: por frame se suben solo las celdas visitadas desde el anterior
+    // (o el nivel de pirámide que cabe, en grids más grandes que la vista)
+    ExplorationHeatmap& heatmap = solver.getHeatmap();
+    heatmap.enableDirtyTracking();
+    if (GRID_W > HEATMAP_VIEW_PX || GRID_H > HEATMAP_VIEW_PX) heatmap.enablePyramid();
+
+    const int STEPS_PER_FRAME = 4;
+    displayHeatmap(grid, heatmap, fontPtr, "Exploration Heatmap (Sparse Matrix, A* en vivo)", [&]() {
+        for (int i = 0; i < STEPS_PER_FRAME && !solver.finished(); ++i) solver.step();
+    });
+}
+
+// Vista RGBA de un heatmap: una celda por píxel si el grid cabe en
+// HEATMAP_VIEW_PX (incremental si el heatmap sigue cambios), si no el nivel
+// de su pirámide que cabe
+struct HeatmapView {
+    int level = 0;  // 0 = celda por píxel
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+    std::optional<MipPyramid> ownPyramid;  // Solo si el heatmap no tiene pirámide activa
+    int paintedVisits = -1;
+
+    HeatmapView(const ExplorationHeatmap& heatmap, int gridW, int gridH) : width(gridW), height(gridH) {
+        if (gridW > HEATMAP_VIEW_PX || gridH > HEATMAP_VIEW_PX) {
+            const MipPyramid* pyramid = heatmap.getPyramid();
+            if (!pyramid) {
+                // Heatmap sin pirámide (p.ej. ya terminado): armarla una vez desde
+                // las celdas visitadas, sin copiar el heatmap
+                ownPyramid.emplace(gridW, gridH);
+                std::vector<std::uint32_t> counts(static_cast<size_t>(gridW) * gridH, 0);
+                heatmap.forEachVisited([&](int x, int y, int visits) {
+                    counts[static_cast<size_t>(y) * gridW + x] = static_cast<std::uint32_t>(visits);
+                });
+                ownPyramid->assign(counts);
+                pyramid = &*ownPyramid;
+            }
+            level = pyramid->levelToFit(HEATMAP_VIEW_PX, HEATMAP_VIEW_PX);
+            width = pyramid->levelWidth(level);
+            height = pyramid->levelHeight(level);
+        }
+        pixels.assign(static_cast<size_t>(width) * height * 4, 0);
     }
 
-    const ExplorationHeatmap& heatmap = solver.getHeatmap();
+    // Repintar si hubo visitas nuevas; true si cambió el buffer
+    bool refresh(const ExplorationHeatmap& heatmap) {
+        int visits = heatmap.getStats().totalVisits;
+        if (visits == paintedVisits) return false;
+        paintedVisits = visits;
+
+        if (level == 0) {
+            heatmap.writeRGBA(pixels.data());
+        } else {
+            const MipPyramid& pyramid = ownPyramid ? *ownPyramid : *heatmap.getPyramid();
+            pyramid.writeRGBA(level, MipPyramid::Reduce::SUM, pixels.data());
+        }
+        return true;
+    }
+};
 
-    // Mostrar usando la función auxiliar
-    displayHeatmap(grid, heatmap, fontPtr, "Exploration Heatmap (Sparse Matrix)");
+std::vector<std::string> heatmapInfoLines(const ExplorationHeatmap& heatmap, const HeatmapView& view,
+                                          int gridW, int gridH) {
+    ExplorationHeatmap::HeatmapStats stats = heatmap.getStats();
+    std::vector<std::string> infoLines = {
+        "Total Visits: " + std::to_string(stats.totalVisits),
+        "Unique Cells: " + std::to_string(stats.uniqueCells),
+        "Max Visits: " + std::to_string(stats.maxVisits),
+        "Avg Visits: " + std::to_string(static_cast<int>(stats.avgVisits)),
+        "Coverage: " + std::to_string(static_cast<int>(stats.densityPercent)) + "%",
+        "",
+        std::string("Storage: ") + (heatmap.isDense() ? "Dense array" : "Sparse hash"),
+        "Size: " + std::to_string(stats.uniqueCells) + " entries",
+        "vs Full: " + std::to_string(gridW * gridH),
+        "Memory: " + std::to_string(heatmap.bytesUsed()) + " bytes"
+    };
+    if (view.level > 0) {
+        infoLines.push_back("Zoom: level " + std::to_string(view.level) + " (" + std::to_string(1 << view.level) + "x"
+                            + std::to_string(1 << view.level) + " cells/px)");
+    }
+    return infoLines;
 }
 
-// Función auxiliar para mostrar un heatmap dado
+// Función auxiliar para mostrar un heatmap dado. advance (opcional) se llama
+// una vez por frame (p.ej. para avanzar el solver dueño del heatmap) y la
+// textura se actualiza si hubo visitas nuevas
 void displayHeatmap(const Grid& grid, const ExplorationHeatmap& heatmap,
-                   const sf::Font* fontPtr, const std::string& windowTitle) {
-    const int CELL_SIZE = 20;
+                   const sf::Font* fontPtr, const std::string& windowTitle,
+                   const std::function<void()>& advance) {
     const int GRID_W = grid.width();
     const int GRID_H = grid.height();
 
-    ExplorationHeatmap::HeatmapStats stats = heatmap.getStats();
-    std::vector<std::vector<float>> normalizedGrid = heatmap.toNormalizedGrid();
+    HeatmapView view(heatmap, GRID_W, GRID_H);
+    view.refresh(heatmap);
+    std::vector<std::string> infoLines = heatmapInfoLines(heatmap, view, GRID_W, GRID_H);
+
+    std::function<bool()> refresh;
+    if (advance) {
+        refresh = [&]() {
+            advance();
+            if (!view.refresh(heatmap)) return false;
+            infoLines = heatmapInfoLines(heatmap, view, GRID_W, GRID_H);
+            return true;
+        };
+    }
+    displayColorGrid(view.width, view.height, view.pixels, "Heatmap Stats", infoLines, fontPtr, windowTitle, refresh);
+}
+
+// Ventana genérica: píxeles RGBA viewW x viewH (HeatmapColormap) + panel de texto
+// (la usan el heatmap de exploración, el campo de distancias y los agregados)
+// refresh (opcional): se llama una vez por frame; si retorna true, 'pixels' e
+// 'infoLines' (del llamador) cambiaron y se vuelve a subir la textura
+void displayColorGrid(int viewW, int viewH, const std::vector<std::uint8_t>& pixels,
+                      const std::string& panelTitle, const std::vector<std::string>& infoLines,
+                      const sf::Font* fontPtr, const std::string& windowTitle,
+                      const std::function<bool()>& refresh) {
+    const int GRID_W = viewW;
+    const int GRID_H = viewH;
+    const int CELL_SIZE = std::max(1, std::min(20, HEATMAP_VIEW_PX / std::max(GRID_W, GRID_H)));
+    const int VIEW_H = std::max(GRID_H * CELL_SIZE, 560);  // Alto mínimo para el panel
 
     // Ventana de visualización
-    sf::RenderWindow heatWindow(sf::VideoMode(sf::Vector2u(GRID_W * CELL_SIZE + 300, GRID_H * CELL_SIZE)),
+    sf::RenderWindow heatWindow(sf::VideoMode(sf::Vector2u(GRID_W * CELL_SIZE + 300, VIEW_H)),
                                 windowTitle);
     heatWindow.setFramerateLimit(60);
 
+    // Una textura de GRID_W x GRID_H escalada a CELL_SIZE: una sola subida
+    // en vez de GRID_W * GRID_H RectangleShape por frame
+    sf::Texture heatTexture;
+    if (!heatTexture.resize(sf::Vector2u(GRID_W, GRID_H))) return;
+    heatTexture.setSmooth(false);
+    heatTexture.update(pixels.data());
+    sf::Sprite heatSprite(heatTexture);
+    heatSprite.setScale(sf::Vector2f(static_cast<float>(CELL_SIZE), static_cast<float>(CELL_SIZE)));
+
     while (heatWindow.isOpen()) {
         while (auto evOpt = heatWindow.pollEvent()) {
             const sf::Event& ev = *evOpt;
@@ -1107,61 +1312,25 @@ void displayHeatmap(const Grid& grid, const ExplorationHeatmap& heatmap,
             }
         }
 
+        if (refresh && refresh()) heatTexture.update(pixels.data());
+
         heatWindow.clear(sf::Color(20, 20, 20));
 
         // Dibujar heatmap
-        for (int y = 0; y < GRID_H; y++) {
-            for (int x = 0; x < GRID_W; x++) {
-                float intensity = normalizedGrid[x][y];
-
-                sf::RectangleShape cell(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-                cell.setPosition(sf::Vector2f(x * CELL_SIZE, y * CELL_SIZE));
-
-                // Gradiente: azul (frío) -> verde -> amarillo -> rojo (caliente)
-                sf::Color cellColor;
-                if (intensity == 0.0f) {
-                    cellColor = sf::Color(10, 10, 10);  // No visitado
-                } else if (intensity < 0.33f) {
-                    float t = intensity / 0.33f;
-                    cellColor = sf::Color(0, static_cast<int>(t * 100), static_cast<int>(100 + t * 155));
-                } else if (intensity < 0.66f) {
-                    float t = (intensity - 0.33f) / 0.33f;
-                    cellColor = sf::Color(static_cast<int>(t * 255), static_cast<int>(100 + t * 155), static_cast<int>(255 - t * 255));
-                } else {
-                    float t = (intensity - 0.66f) / 0.34f;
-                    cellColor = sf::Color(255, static_cast<int>(255 - t * 100), 0);
-                }
-
-                cell.setFillColor(cellColor);
-                heatWindow.draw(cell);
-            }
-        }
+        heatWindow.draw(heatSprite);
 
         // Panel de información
         if (fontPtr) {
             float panelX = GRID_W * CELL_SIZE + 20;
             float yPos = 20;
 
-            sf::Text title(*fontPtr, "Heatmap Stats", 20);
+            sf::Text title(*fontPtr, panelTitle, 20);
             title.setPosition(sf::Vector2f(panelX, yPos));
             title.setFillColor(sf::Color(255, 215, 0));
             heatWindow.draw(title);
 
             yPos += 40;
 
-            std::vector<std::string> infoLines = {
-                "Total Visits: " + std::to_string(stats.totalVisits),
-                "Unique Cells: " + std::to_string(stats.uniqueCells),
-                "Max Visits: " + std::to_string(stats.maxVisits),
-                "Avg Visits: " + std::to_string(static_cast<int>(stats.avgVisits)),
-                "Coverage: " + std::to_string(static_cast<int>(stats.densityPercent)) + "%",
-                "",
-                "Sparse Matrix:",
-                "Size: " + std::to_string(stats.uniqueCells) + " entries",
-                "vs Full: " + std::to_string(GRID_W * GRID_H),
-                "Saved: " + std::to_string(GRID_W * GRID_H - stats.uniqueCells)
-            };
-
             for (const auto& line : infoLines) {
                 sf::Text text(*fontPtr, line, 14);
                 text.setPosition(sf::Vector2f(panelX, yPos));
@@ -1200,7 +1369,7 @@ void displayHeatmap(const Grid& grid, const ExplorationHeatmap& heatmap,
 
             // Hint
             sf::Text hint(*fontPtr, "Close window to return to menu", 12);
-            hint.setPosition(sf::Vector2f(panelX, GRID_H * CELL_SIZE - 30));
+            hint.setPosition(sf::Vector2f(panelX, VIEW_H - 30));
             hint.setFillColor(sf::Color(150, 150, 150));
             heatWindow.draw(hint);
         }
@@ -1235,15 +1404,13 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
     
     Coord start(grid.width() / 2, grid.height() / 2);
     Coord goal = getRandomCorner(grid, start);
+    
+    // Campo de flujo hacia la meta: se repara tras cada Origin Shift (tecla F lo muestra)
+    std::unique_ptr<FlowField> flowField;
+    int lastFlowRepair = 0;
 
-    auto drawLine = [&](sf::RenderTarget& target, float x1, float y1, float x2, float y2, const sf::Color& col) {
-        sf::Vertex verts[2];
-        verts[0].position = sf::Vector2f(x1, y1);
-        verts[0].color = col;
-        verts[1].position = sf::Vector2f(x2, y2);
-        verts[1].color = col;
-        target.draw(verts, 2, sf::PrimitiveType::Lines);
-    };
+    // Paredes cacheadas: solo se rearman las líneas que cambian con removeWall
+    WallMesh wallMesh(grid, static_cast<float>(cellSize), sf::Color(220, 220, 220));
 
     while (window.isOpen()) {
         while (auto evOpt = window.pollEvent()) {
@@ -1252,6 +1419,25 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
                 window.close();
                 return;
             }
+
+            if (ev.is<sf::Event::KeyPressed>()) {
+                const auto* keyEv = ev.getIf<sf::Event::KeyPressed>();
+                if (flowField && keyEv && keyEv->code == sf::Keyboard::Key::F) {
+                    std::vector<std::string> infoLines = {
+                        "Goal: (" + std::to_string(goal.x) + ", " + std::to_string(goal.y) + ")",
+                        "Max Distance: " + std::to_string(flowField->getMaxDistance()),
+                        "Start Distance: " + std::to_string(flowField->getDistance(start.x, start.y)),
+                        "Last Repair: " + std::to_string(lastFlowRepair) + " cells",
+                        "",
+                        "Near goal = cold, far = hot"
+                    };
+                    std::vector<std::uint8_t> pixels(static_cast<size_t>(grid.width()) * grid.height() * 4);
+                    HeatmapColormap::writeNormalized(flowField->toNormalizedGrid(), pixels.data());
+                    displayColorGrid(grid.width(), grid.height(), pixels, "Flow Field", infoLines,
+                                     fontPtr, title + " - Goal Distance Field");
+                    clock.restart();
+                }
+            }
         }
 
         sf::Time dt = clock.restart();
@@ -1264,6 +1450,7 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
                 // Inicializar Origin Shift después de generar el laberinto
                 originShift = std::make_unique<OriginShiftMaze>(grid);
                 originShift->initializeFromMaze();
+                flowField = std::make_unique<FlowField>(grid, goal);
                 mazeGenerated = true;
             } else if (!solverStarted) {
                 // Iniciar solver
@@ -1281,6 +1468,7 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
             while (originShiftAccum >= originShiftTime) {
                 originShift->update();
                 originShift->applyToGrid();
+                if (flowField) lastFlowRepair = flowField->update(originShift->getChangedCells());
                 originShiftAccum -= originShiftTime;
             }
         }
@@ -1299,14 +1487,9 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
                     rect.setFillColor(sf::Color(46, 46, 46));
                     window.draw(rect);
                 }
-
-                // Paredes
-                if (grid.at(x, y).walls[0]) drawLine(window, xpos, ypos, xpos + cellSize, ypos, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[1]) drawLine(window, xpos, ypos, xpos, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[2]) drawLine(window, xpos + cellSize, ypos, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[3]) drawLine(window, xpos, ypos + cellSize, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
             }
         }
+        wallMesh.draw(window);  // Todas las paredes en una sola llamada
         
         // Dibujar TODAS las raíces del Origin Shift (cada una con color diferente)
         if (originShift) {
@@ -1375,7 +1558,8 @@ void runOriginShiftMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
             if (originShift) {
                 std::string graphInfo = "Graph: " + std::to_string(originShift->getNodeCount()) + " nodes, " 
                                       + std::to_string(originShift->getEdgeCount()) + " edges, "
-                                      + std::to_string(originShift->getRoots().size()) + " active roots";
+                                      + std::to_string(originShift->getRoots().size()) + " active roots"
+                                      + (flowField ? "  |  [F] Flow field" : "");
                 sf::Text infoText(*fontPtr, graphInfo, 12);
                 infoText.setPosition(sf::Vector2f(6.f, 26.f));
                 infoText.setFillColor(sf::Color(100, 255, 255));
@@ -1408,6 +1592,9 @@ void runPortalMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
     
     std::unique_ptr<PortalSystem> portals;
     std::unique_ptr<MazeSolver> solver;
+    // A* y UCS usan los portales como aristas extra
+    std::unique_ptr<AStarSolver> aStarSolver;
+    std::unique_ptr<UCSSolver> ucsSolver;
     bool mazeGenerated = false;
     bool solverStarted = false;
     
@@ -1425,6 +1612,9 @@ void runPortalMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
         target.draw(verts, 2, sf::PrimitiveType::Lines);
     };
 
+    // Paredes cacheadas: solo se rearman las líneas que cambian con removeWall
+    WallMesh wallMesh(grid, static_cast<float>(cellSize), sf::Color(220, 220, 220));
+
     while (window.isOpen()) {
         while (auto evOpt = window.pollEvent()) {
             const sf::Event& ev = *evOpt;
@@ -1450,8 +1640,18 @@ void runPortalMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
                 
                 mazeGenerated = true;
             } else if (!solverStarted) {
-                solver = std::make_unique<MazeSolver>(grid, start, goal);
+                if (strategy == SolverStrategy::ASTAR) {
+                    aStarSolver = std::make_unique<AStarSolver>(grid, start, goal, portals.get());
+                } else if (strategy == SolverStrategy::UCS) {
+                    ucsSolver = std::make_unique<UCSSolver>(grid, start, goal, portals.get());
+                } else {
+                    solver = std::make_unique<MazeSolver>(grid, start, goal);
+                }
                 solverStarted = true;
+            } else if (aStarSolver) {
+                if (!aStarSolver->finished()) aStarSolver->step();
+            } else if (ucsSolver) {
+                if (!ucsSolver->finished()) ucsSolver->step();
             } else if (!solver->finished()) {
                 solver->step();
             }
@@ -1472,13 +1672,9 @@ void runPortalMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
                     rect.setFillColor(sf::Color(46, 46, 46));
                     window.draw(rect);
                 }
-
-                if (grid.at(x, y).walls[0]) drawLine(window, xpos, ypos, xpos + cellSize, ypos, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[1]) drawLine(window, xpos, ypos, xpos, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[2]) drawLine(window, xpos + cellSize, ypos, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
-                if (grid.at(x, y).walls[3]) drawLine(window, xpos, ypos + cellSize, xpos + cellSize, ypos + cellSize, sf::Color(220,220,220));
             }
         }
+        wallMesh.draw(window);  // Todas las paredes en una sola llamada
         
         // Dibujar diámetro (Cyan)
         if (diameterCalculated && graphStats.path.size() > 1) {
@@ -1555,6 +1751,40 @@ void runPortalMode(Grid& grid, MazeAlgorithm& algo, int cellSize,
             }
         }
 
+        // Solvers con portales (A*/UCS): celdas cerradas + camino con saltos
+        auto drawPortalSolver = [&](auto& solverPtr) {
+            const auto& states = solverPtr->getStateGrid();
+            for (int y = 0; y < grid.height(); ++y) {
+                for (int x = 0; x < grid.width(); ++x) {
+                    if (states[x][y] == 2) { // CLOSED
+                        sf::RectangleShape r(sf::Vector2f((float)cellSize, (float)cellSize));
+                        r.setPosition(sf::Vector2f(x * cellSize, y * cellSize));
+                        r.setFillColor(sf::Color(180, 50, 255, 80));
+                        window.draw(r);
+                    }
+                }
+            }
+
+            Coord cur;
+            if (solverPtr->getCurrent(cur)) {
+                sf::RectangleShape s(sf::Vector2f((float)cellSize, (float)cellSize));
+                s.setPosition(sf::Vector2f((float)cur.x * cellSize, (float)cur.y * cellSize));
+                s.setFillColor(sf::Color(255, 200, 0, 170));
+                window.draw(s);
+            }
+
+            const std::vector<Coord>& sol = solverPtr->getSolution();
+            for (size_t i = 1; i < sol.size(); ++i) {
+                float ax = sol[i-1].x * cellSize + cellSize * 0.5f;
+                float ay = sol[i-1].y * cellSize + cellSize * 0.5f;
+                float bx = sol[i].x * cellSize + cellSize * 0.5f;
+                float by = sol[i].y * cellSize + cellSize * 0.5f;
+                drawLine(window, ax, ay, bx, by, sf::Color(255, 200, 0, 230));
+            }
+        };
+        if (aStarSolver) drawPortalSolver(aStarSolver);
+        else if (ucsSolver) drawPortalSolver(ucsSolver);
+
         // Overlay
         if (fontPtr) {
             sf::Text titleText(*fontPtr, "PORTAL JUMPER - Wormholes Active", 16);